@@ -45,4 +45,5 @@ struct IdentityFunctor {
 #include "impl/Algorithms/NonModifying.hxx"
 #include "impl/Algorithms/Numerical.hxx"
 #include "impl/Algorithms/Partitioning.hxx"
+#include "impl/Algorithms/Sorting.hxx"
 #include "impl/Algorithms/Transformations.hxx"
@@ -0,0 +1,123 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Compile-time half of the benchmark suite: evaluates the operations that Containers.cxx times at runtime in a
+     static_assert, for the area selected by defining one of BENCHMARK_VECTOR, BENCHMARK_FLATMAP,
+     BENCHMARK_STABLEVECTOR, BENCHMARK_CHUNKPOOL, BENCHMARK_BITSET or BENCHMARK_PRINTF, with BENCHMARK_N elements
+     or operations. With none of them defined, only the headers are compiled. compile_time.sh compiles this for each
+     area and a range of N, and reports the time taken and the number of constexpr operations required.
+     Build with e.g. g++ -std=c++1z -fsyntax-only -I.. -DBENCHMARK_VECTOR -DBENCHMARK_N=256 CompileTime.cxx */
+
+#include "../Bitset.hxx"
+#include "../ChunkPool.hxx"
+#include "../FlatMap.hxx"
+#include "../Parser.hxx"
+#include "../StableVector.hxx"
+#include "../StaticPrintf.hxx"
+#include "../Vector.hxx"
+
+using namespace Constainer;
+
+#ifndef BENCHMARK_N
+	#define BENCHMARK_N 256
+#endif
+
+constexpr STD::size_t N = BENCHMARK_N;
+
+/**< A linear congruential generator, whose values determine the positions and keys. */
+constexpr STD::uint32_t next(STD::uint32_t& state) {
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+#ifdef BENCHMARK_VECTOR
+/**< Inserts N elements at random positions, then erases half of them at random positions. */
+constexpr auto vectorInsertErase() {
+	Vector<int, N> v;
+	STD::uint32_t rng = 1;
+	for (STD::size_t i = 0; i != N; ++i)
+		v.insert(v.begin() + next(rng) % (v.size()+1), int(i));
+	for (STD::size_t i = 0; i != N/2; ++i)
+		v.erase(v.begin() + next(rng) % v.size());
+	return v.size();
+}
+static_assert( vectorInsertErase() == N - N/2, "" );
+#endif
+
+#ifdef BENCHMARK_FLATMAP
+/**< Inserts N random keys, then looks each of them up. */
+constexpr auto flatMapBuildLookup() {
+	FlatMap<unsigned, int, N> map;
+	STD::uint32_t rng = 1;
+	for (STD::size_t i = 0; i != N; ++i)
+		map.emplace(unsigned(next(rng) % (2*N)), int(i));
+	STD::size_t found = 0;
+	rng = 1;
+	for (STD::size_t i = 0; i != N; ++i)
+		found += map.count(unsigned(next(rng) % (2*N)));
+	return found;
+}
+static_assert( flatMapBuildLookup() == N, "" );
+#endif
+
+#ifdef BENCHMARK_STABLEVECTOR
+/**< Inserts N elements in the middle. */
+constexpr auto stableVectorMiddleInsert() {
+	SegmentedStableVector<int, N> v;
+	for (STD::size_t i = 0; i != N; ++i)
+		v.insert(v.begin() + v.size()/2, int(i));
+	return v.size();
+}
+static_assert( stableVectorMiddleInsert() == N, "" );
+#endif
+
+#ifdef BENCHMARK_CHUNKPOOL
+/**< Grabs all N slots, then frees and regrabs N of them in random order. */
+constexpr auto chunkPoolGrabFree() {
+	ChunkPool<int, N> pool;
+	int* slots[N] {};
+	for (auto& p : slots)
+		p = pool.grab();
+	STD::uint32_t rng = 1;
+	for (STD::size_t i = 0; i != N; ++i) {
+		auto j = next(rng) % N;
+		pool.free(slots[j]);
+		slots[j] = pool.grab();
+	}
+	return pool.used();
+}
+static_assert( chunkPoolGrabFree() == N, "" );
+#endif
+
+#ifdef BENCHMARK_BITSET
+/**< Sets N random bits of 64*N, then counts them and visits each set bit. */
+constexpr auto bitsetScan() {
+	Bitset<64*N> bits;
+	STD::uint32_t rng = 1;
+	for (STD::size_t i = 0; i != N; ++i)
+		bits.set(next(rng) % (64*N));
+	STD::size_t visited = 0;
+	for (auto i = bits.find_next(0, true); i != bits.size(); i = bits.find_next(i+1, true))
+		++visited;
+	return visited == bits.count();
+}
+static_assert( bitsetScan(), "" );
+#endif
+
+#ifdef BENCHMARK_PRINTF
+/**< Formats N integers with %d and parses them back with strToInt. */
+constexpr auto printAndParse() {
+	STD::uint32_t rng = 1;
+	for (STD::size_t i = 0; i != N; ++i) {
+		long long v = static_cast<long long>(next(rng)) * next(rng) - (1ll << 40);
+		auto s = "%d"_ConstainerStaticPrintf(v);
+		if (strToInt<long long>(s.data(), s.size()) != v)
+			return false;
+	}
+	return true;
+}
+static_assert( printAndParse(), "" );
+#endif
+
+int main() {}
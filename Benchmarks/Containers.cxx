@@ -0,0 +1,284 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Runtime half of the benchmark suite; CompileTime.cxx and compile_time.sh measure the cost of the same
+     operations in constant expressions. Each area is compared with its standard library counterpart. If built
+     with -DCONSTAINER_STATS, the moves, comparisons and pool probes per operation are reported as well.
+     Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. Containers.cxx */
+
+#include "../Bitset.hxx"
+#include "../ChunkPool.hxx"
+#include "../FlatMap.hxx"
+#include "../Parser.hxx"
+#include "../StableVector.hxx"
+#include "../StaticPrintf.hxx"
+#include "../Vector.hxx"
+
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __has_include(<charconv>)
+	#include <charconv>
+#endif
+
+using namespace Constainer;
+
+static std::size_t sink = 0;
+
+/**< Nanoseconds per operation of f, which performs ops operations. */
+template <typename F>
+double nsPerOp( std::size_t ops, F f ) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / ops;
+}
+
+/**< Prints one line for an area: the time of the Constainer and standard library versions, followed by the
+     counters accumulated by the former. */
+template <typename Ours, typename Theirs>
+void report( char const* area, char const* theirs_name, std::size_t ops, Ours ours, Theirs theirs ) {
+	resetStats();
+	double const t_ours = nsPerOp(ops, ours);
+	Stats const counted = stats();
+	double const t_theirs = nsPerOp(ops, theirs);
+	std::printf("%-42s %9.1f ns, %-15s %9.1f ns", area, t_ours, theirs_name, t_theirs);
+#ifdef CONSTAINER_STATS
+	std::printf("   per op: %8.1f moves, %5.1f comparisons, %4.1f probes", double(counted.moves) / ops,
+	            double(counted.comparisons) / ops, double(counted.probes) / ops);
+#else
+	(void)counted;
+#endif
+	std::printf("\n");
+}
+
+std::vector<std::size_t> randomIndices( std::size_t n, std::size_t seed ) {
+	std::mt19937_64 rng(seed);
+	std::vector<std::size_t> v(n);
+	for (auto& i : v)
+		i = rng();
+	return v;
+}
+
+/**< --------- Vector ---------*/
+
+/**< Alternately inserts and erases at random positions, such that the size stays around N/2. */
+template <typename Vec>
+struct InsertErase {
+	Vec& vec;
+	std::vector<std::size_t> const& positions;
+	void operator()() const {
+		for (std::size_t i = 0; i != positions.size(); ++i)
+			if (i % 2 && !vec.empty())
+				vec.erase(vec.begin() + positions[i] % vec.size());
+			else
+				vec.insert(vec.begin() + positions[i] % (vec.size()+1), int(i));
+		sink += vec.size();
+	}
+};
+
+template <std::size_t N>
+void runVector() {
+	auto positions = randomIndices(1 << 16, N);
+	auto ours = std::make_unique<Vector<int, N>>(N/2);
+	std::vector<int> theirs(N/2);
+	char name[64];
+	std::snprintf(name, sizeof name, "Vector insert/erase, %zu elements", N/2);
+	report(name, "std::vector", positions.size(), InsertErase<Vector<int, N>>{*ours, positions},
+	       InsertErase<std::vector<int>>{theirs, positions});
+}
+
+/**< --------- FlatMap ---------*/
+
+template <typename Map>
+struct BuildAndLookup {
+	Map& map;
+	std::vector<std::size_t> const& keys;
+	void operator()() const {
+		for (auto k : keys)
+			map.emplace(unsigned(k % (2*keys.size())), int(k));
+		for (auto k : keys)
+			sink += map.count(unsigned(k % (2*keys.size())));
+	}
+};
+
+template <std::size_t N>
+void runFlatMap() {
+	auto keys = randomIndices(N, N);
+	auto ours = std::make_unique<FlatMap<unsigned, int, N>>();
+	std::map<unsigned, int> theirs;
+	char name[64];
+	std::snprintf(name, sizeof name, "FlatMap build and lookup, %zu keys", N);
+	report(name, "std::map", 2*N, BuildAndLookup<FlatMap<unsigned, int, N>>{*ours, keys},
+	       BuildAndLookup<std::map<unsigned, int>>{theirs, keys});
+}
+
+/**< --------- StableVector ---------*/
+
+template <typename Vec>
+struct MiddleInsert {
+	Vec& vec;
+	std::size_t count;
+	void operator()() const {
+		for (std::size_t i = 0; i != count; ++i)
+			vec.insert(vec.begin() + vec.size()/2, int(i));
+		sink += vec.size();
+	}
+};
+
+template <std::size_t N>
+void runStableVector() {
+	auto ours = std::make_unique<SegmentedStableVector<int, N>>();
+	std::vector<int> theirs;
+	char name[64];
+	std::snprintf(name, sizeof name, "SegmentedStableVector middle insert, %zu", N);
+	report(name, "std::vector", N, MiddleInsert<SegmentedStableVector<int, N>>{*ours, N},
+	       MiddleInsert<std::vector<int>>{theirs, N});
+}
+
+/**< --------- ChunkPool ---------*/
+
+/**< Grabs all N slots, then frees and regrabs them in random order. */
+template <std::size_t N>
+struct PoolGrabFree {
+	ChunkPool<int, N>& pool;
+	std::vector<std::size_t> const& order;
+	void operator()() const {
+		std::vector<int*> slots(N);
+		for (auto& p : slots)
+			p = pool.grab();
+		for (auto i : order) {
+			pool.free(slots[i % N]);
+			slots[i % N] = pool.grab();
+		}
+		sink += pool.used();
+	}
+};
+
+template <std::size_t N>
+struct AllocatorGrabFree {
+	std::vector<std::size_t> const& order;
+	void operator()() const {
+		std::allocator<int> alloc;
+		std::vector<int*> slots(N);
+		for (auto& p : slots)
+			p = alloc.allocate(1);
+		for (auto i : order) {
+			alloc.deallocate(slots[i % N], 1);
+			slots[i % N] = alloc.allocate(1);
+		}
+		for (auto p : slots)
+			alloc.deallocate(p, 1);
+		sink += slots.size();
+	}
+};
+
+template <std::size_t N>
+void runChunkPool() {
+	auto order = randomIndices(1 << 18, N);
+	auto ours = std::make_unique<ChunkPool<int, N>>();
+	char name[64];
+	std::snprintf(name, sizeof name, "ChunkPool grab/free, %zu slots", N);
+	report(name, "std::allocator", N + order.size(), PoolGrabFree<N>{*ours, order}, AllocatorGrabFree<N>{order});
+}
+
+/**< --------- Bitset ---------*/
+
+/**< Counts the set bits, then visits each of them. */
+template <std::size_t N>
+struct BitsetScan {
+	Bitset<N> const& bits;
+	void operator()() const {
+		for (int r = 0; r < 64; ++r) {
+			sink += bits.count();
+			for (auto i = bits.find_next(0, true); i != N; i = bits.find_next(i+1, true))
+				sink += i;
+		}
+	}
+};
+template <std::size_t N>
+struct StdBitsetScan {
+	std::bitset<N> const& bits;
+	void operator()() const {
+		for (int r = 0; r < 64; ++r) {
+			sink += bits.count();
+			for (std::size_t i = 0; i != N; ++i)
+				if (bits.test(i))
+					sink += i;
+		}
+	}
+};
+
+template <std::size_t N>
+void runBitset() {
+	std::mt19937 rng(N);
+	auto ours = std::make_unique<Bitset<N>>();
+	auto theirs = std::make_unique<std::bitset<N>>();
+	for (std::size_t i = 0; i < N/64; ++i) {
+		auto pos = rng() % N;
+		ours->set(pos);
+		theirs->set(pos);
+	}
+	char name[64];
+	std::snprintf(name, sizeof name, "Bitset count and scan, %zu bits", N);
+	report(name, "std::bitset", 64, BitsetScan<N>{*ours}, StdBitsetScan<N>{*theirs});
+}
+
+/**< --------- StaticPrintf and strToInt ---------*/
+
+struct PrintAndParse {
+	std::vector<long long> const& values;
+	void operator()() const {
+		for (auto v : values) {
+			auto s = "%d"_ConstainerStaticPrintf(v);
+			sink += strToInt<long long>(s.data(), s.size());
+		}
+	}
+};
+struct StdPrintAndParse {
+	std::vector<long long> const& values;
+	void operator()() const {
+		for (auto v : values) {
+#if defined __cpp_lib_to_chars || (defined __GNUC__ && __GNUC__ >= 8)
+			char buf[24];
+			long long r = 0;
+			auto end = std::to_chars(buf, buf + sizeof buf, v).ptr;
+			std::from_chars(buf, end, r);
+			sink += r;
+#else
+			sink += std::stoll(std::to_string(v));
+#endif
+		}
+	}
+};
+
+void runPrintParse() {
+	std::mt19937_64 rng(1);
+	std::vector<long long> values(1 << 18);
+	for (auto& v : values)
+		v = static_cast<long long>(rng()) >> (rng() % 64);
+	report("StaticPrintf %d and strToInt", "to/from_chars", values.size(), PrintAndParse{values},
+	       StdPrintAndParse{values});
+}
+
+int main() {
+	runVector<1 << 10>();
+	runVector<1 << 14>();
+	runFlatMap<1 << 10>();
+	runFlatMap<1 << 14>();
+	runStableVector<1 << 10>();
+	runStableVector<1 << 16>();
+	runChunkPool<1 << 6>();
+	runChunkPool<1 << 14>();
+	runBitset<1 << 12>();
+	runBitset<1 << 20>();
+	runPrintParse();
+	return sink == 0;
+}
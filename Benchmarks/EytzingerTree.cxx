@@ -0,0 +1,52 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Compares EytzingerSet::find with FlatSet::find for sets of 1K, 64K and 1M elements.
+     Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. EytzingerTree.cxx */
+
+#include "../EytzingerTree.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Constainer;
+
+template <typename Set>
+double nsPerLookup( Set const& set, std::vector<unsigned> const& keys, std::size_t& found ) {
+	auto start = std::chrono::steady_clock::now();
+	for (auto k : keys)
+		found += set.find(k) != set.end();
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / keys.size();
+}
+
+template <std::size_t N>
+void run() {
+	std::mt19937 rng(N);
+	std::vector<unsigned> values(N);
+	for (auto& v : values)
+		v = rng();
+
+	auto flat  = std::make_unique<FlatSet<unsigned, N>>(values.begin(), values.end());
+	auto eytz  = std::make_unique<EytzingerSet<unsigned, N>>(*flat);
+
+	// Half of the lookups hit
+	std::vector<unsigned> keys(1 << 22);
+	for (std::size_t i = 0; i != keys.size(); ++i)
+		keys[i] = i % 2? values[rng() % N] : rng();
+
+	std::size_t found = 0;
+	double tf = nsPerLookup(*flat, keys, found),
+	       te = nsPerLookup(*eytz, keys, found);
+	std::printf("%8zu elements: FlatSet %6.1f ns, EytzingerSet %6.1f ns (%zu hits)\n", N, tf, te, found/2);
+}
+
+int main() {
+	run<1 << 10>();
+	run<1 << 16>();
+	run<1 << 20>();
+}
@@ -0,0 +1,120 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Measures the throughput of strToInt, strToFloat and parseDelimited on delimited numeric text, compared with
+     strtoll and strtod. Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. Parser.cxx */
+
+#include "../Parser.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace Constainer;
+
+static double sink = 0;
+
+/**< Nanoseconds per field of f, which parses the whole text. */
+template <typename F>
+double nsPerField( std::string const& text, std::size_t fields, F f ) {
+	auto start = std::chrono::steady_clock::now();
+	f(text.data(), text.data() + text.size());
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / fields;
+}
+
+ParserState<char const*> parseOne(char const* first, char const* last, long long& res) {return strToInt(first, last, res);}
+ParserState<char const*> parseOne(char const* first, char const* last, double& res) {return strToFloat(first, last, res);}
+
+template <typename T>
+struct StrTo {
+	void operator()(char const* first, char const* last) const {
+		T value{};
+		while (first != last) {
+			auto st = parseOne(first, last, value);
+			sink += value;
+			first = st.iterator + (st.iterator != last);
+		}
+	}
+};
+
+template <typename T>
+struct CStrTo {
+	void operator()(char const* first, char const* last) const {
+		char* end = nullptr;
+		while (first != last) {
+			sink += std::is_integral<T>{}? std::strtoll(first, &end, 10) : std::strtod(first, &end);
+			first = end + (end != last);
+		}
+	}
+};
+
+template <typename T>
+struct Batch {
+	void operator()(char const* first, char const* last) const {
+		Vector<T, 4096> values;
+		while (first != last) {
+			values.clear();
+			// Parse up to a line's worth of fields at a time
+			auto line_end = std::find(first, last, '\n');
+			auto st = parseDelimited(first, line_end, values, ',');
+			for (auto v : values)
+				sink += v;
+			first = st.iterator + (st.iterator != last);
+		}
+	}
+};
+
+template <typename T, typename Generate>
+void run( char const* name, Generate generate ) {
+	std::mt19937_64 rng(42);
+	std::string text;
+	std::size_t const fields = 1 << 20;
+	for (std::size_t i = 0; i < fields; ++i) {
+		text += generate(rng);
+		text += i % 1024 == 1023? '\n' : ',';
+	}
+	text.pop_back();
+
+	std::printf("%-28s strTo %6.1f ns, parseDelimited %6.1f ns, C library %6.1f ns per field\n", name,
+	            nsPerField(text, fields, StrTo<T>{}), nsPerField(text, fields, Batch<T>{}),
+	            nsPerField(text, fields, CStrTo<T>{}));
+}
+
+struct Integers {
+	std::string operator()(std::mt19937_64& rng) const {return std::to_string(static_cast<long long>(rng()) >> (rng() % 64));}
+};
+struct ShortDecimals {
+	std::string operator()(std::mt19937_64& rng) const {
+		char buf[32];
+		std::snprintf(buf, sizeof buf, "%.2f", double(rng() % 10000000) / 100);
+		return buf;
+	}
+};
+struct RoundTripDoubles {
+	std::string operator()(std::mt19937_64& rng) const {
+		char buf[32];
+		std::snprintf(buf, sizeof buf, "%.17g", std::uniform_real_distribution<>(-1e6, 1e6)(rng));
+		return buf;
+	}
+};
+struct WideDoubles {
+	std::string operator()(std::mt19937_64& rng) const {
+		char buf[32];
+		std::snprintf(buf, sizeof buf, "%.17g", std::ldexp(std::uniform_real_distribution<>(1, 2)(rng), int(rng() % 2000) - 1000));
+		return buf;
+	}
+};
+
+int main() {
+	run<long long>("Integers", Integers{});
+	run<double>("Two decimal places", ShortDecimals{});
+	run<double>("17 digits in [-1e6, 1e6)", RoundTripDoubles{});
+	run<double>("17 digits, wide exponents", WideDoubles{});
+	return sink == 0;
+}
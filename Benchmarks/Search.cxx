@@ -0,0 +1,146 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Measures substring and character set searches in a large log-like text: BasicString's find, rfind and
+     find_first_of, the element-wise search and TwoWaySearcher, compared with std::string.
+     Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. Search.cxx */
+
+#include "../String.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+
+using namespace Constainer;
+
+constexpr std::size_t text_size = 1 << 20;
+using Text = BasicString<char, text_size>;
+
+static std::size_t sink = 0;
+
+/**< Microseconds per call of f, which is called repeatedly to find every occurrence of its pattern. */
+template <typename F>
+double usPerScan( F f, int repetitions = 20 ) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repetitions; ++i)
+		sink += f();
+	std::chrono::duration<double, std::micro> d = std::chrono::steady_clock::now() - start;
+	return d.count() / repetitions;
+}
+
+struct Find {
+	Text const& text; std::string const& pattern;
+	std::size_t operator()() const {
+		std::size_t n = 0;
+		for (auto p = text.find(pattern.data(), 0, pattern.size()); p != Text::npos;
+		     p = text.find(pattern.data(), p+1, pattern.size()))
+			++n;
+		return n;
+	}
+};
+struct RFind {
+	Text const& text; std::string const& pattern;
+	std::size_t operator()() const {return text.rfind(pattern.data(), Text::npos, pattern.size());}
+};
+struct Naive {
+	Text const& text; std::string const& pattern;
+	std::size_t operator()() const {
+		std::size_t n = 0;
+		for (auto it = text.begin(); (it = Constainer::search(it, text.end(), pattern.begin(), pattern.end(),
+		                                                       std::equal_to<>{})) != text.end(); ++it)
+			++n;
+		return n;
+	}
+};
+struct TwoWay {
+	Text const& text; std::string const& pattern;
+	std::size_t operator()() const {
+		auto searcher = makeTwoWaySearcher(pattern.data(), pattern.data() + pattern.size());
+		std::size_t n = 0;
+		for (auto it = text.begin(); (it = Constainer::search(it, text.end(), searcher)) != text.end(); ++it)
+			++n;
+		return n;
+	}
+};
+struct StdFind {
+	std::string const& text; std::string const& pattern;
+	std::size_t operator()() const {
+		std::size_t n = 0;
+		for (auto p = text.find(pattern); p != std::string::npos; p = text.find(pattern, p+1))
+			++n;
+		return n;
+	}
+};
+struct StdRFind {
+	std::string const& text; std::string const& pattern;
+	std::size_t operator()() const {return text.rfind(pattern);}
+};
+struct FindFirstOf {
+	Text const& text; std::string const& set;
+	std::size_t operator()() const {
+		std::size_t n = 0;
+		for (auto p = text.find_first_of(set.data(), 0, set.size()); p != Text::npos;
+		     p = text.find_first_of(set.data(), p+1, set.size()))
+			++n;
+		return n;
+	}
+};
+struct StdFindFirstOf {
+	std::string const& text; std::string const& set;
+	std::size_t operator()() const {
+		std::size_t n = 0;
+		for (auto p = text.find_first_of(set); p != std::string::npos; p = text.find_first_of(set, p+1))
+			++n;
+		return n;
+	}
+};
+struct Compare {
+	Text const& text; Text const& copy;
+	std::size_t operator()() const {return text.compare(copy) == 0;}
+};
+struct StdCompare {
+	std::string const& text; std::string const& copy;
+	std::size_t operator()() const {return text.compare(copy) == 0;}
+};
+
+void run( char const* name, Text const& text, std::string const& std_text, std::string const& pattern ) {
+	std::printf("%-34s find %8.1f us, element-wise search %8.1f us, TwoWaySearcher %8.1f us, std::string %8.1f us\n",
+	            name, usPerScan(Find{text, pattern}), usPerScan(Naive{text, pattern}),
+	            usPerScan(TwoWay{text, pattern}), usPerScan(StdFind{std_text, pattern}));
+	std::printf("%-34s rfind %7.1f us,                                                 std::string %8.1f us\n",
+	            "", usPerScan(RFind{text, pattern}), usPerScan(StdRFind{std_text, pattern}));
+}
+
+int main() {
+	std::mt19937 rng(42);
+	char const* const levels[] {"info", "debug", "warning", "error"};
+	std::string std_text;
+	while (std_text.size() < text_size - 128) {
+		char line[128];
+		std::snprintf(line, sizeof line, "2016-04-%02u %02u:%02u:%02u [%s] request %u served in %u ms; cache %s\n",
+		              unsigned(rng() % 30 + 1), unsigned(rng() % 24), unsigned(rng() % 60), unsigned(rng() % 60),
+		              levels[rng() % 4], unsigned(rng() % 100000), unsigned(rng() % 1000), rng() % 2? "hit" : "miss");
+		std_text += line;
+	}
+	// A highly periodic stretch, on which the element-wise search degrades to quadratic time
+	std_text.replace(std_text.size()/2, 4096, std::string(4096, 'a'));
+	// Both exceed common stack limits
+	static Text const text(std_text.data(), std_text.size());
+
+	run("Short word (\"error\")", text, std_text, "error");
+	run("Long phrase, no match", text, std_text, "request 99999 served in 999 ms; cache hit");
+	run("Periodic pattern in periodic text", text, std_text, std::string(64, 'a') + 'b');
+
+	std::string const delimiters = "[];%";
+	std::printf("%-34s find_first_of %8.1f us, std::string %8.1f us\n", "Delimiters",
+	            usPerScan(FindFirstOf{text, delimiters}), usPerScan(StdFindFirstOf{std_text, delimiters}));
+
+	static Text const copy = text;
+	std::string const std_copy = std_text;
+	std::printf("%-34s compare %8.1f us, std::string %8.1f us\n", "Equal 1 MiB texts",
+	            usPerScan(Compare{text, copy}), usPerScan(StdCompare{std_text, std_copy}));
+	return sink == 0;
+}
@@ -0,0 +1,51 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Compares insertion and erasure at random positions in StableVector and SegmentedStableVector
+     holding 1K, 16K and 64K elements. Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. StableVector.cxx */
+
+#include "../StableVector.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Constainer;
+
+/**< Alternately inserts and erases at the given positions, such that the size stays around N. */
+template <typename Vec>
+double nsPerOperation( Vec& vec, std::vector<std::size_t> const& positions ) {
+	auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i != positions.size(); ++i)
+		if (i % 2)
+			vec.erase(vec.begin() + positions[i] % vec.size());
+		else
+			vec.insert(vec.begin() + positions[i] % (vec.size()+1), int(i));
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / positions.size();
+}
+
+template <std::size_t N>
+void run() {
+	std::mt19937 rng(N);
+	auto flat = std::make_unique<StableVector<int, N+1>>(N);
+	auto segm = std::make_unique<SegmentedStableVector<int, N+1>>(N);
+
+	std::vector<std::size_t> positions(1 << 18);
+	for (auto& p : positions)
+		p = rng();
+
+	double tf = nsPerOperation(*flat, positions),
+	       ts = nsPerOperation(*segm, positions);
+	std::printf("%6zu elements: StableVector %8.1f ns, SegmentedStableVector %6.1f ns (%s)\n",
+	            N, tf, ts, *flat == *segm? "equal" : "DIFFERENT");
+}
+
+int main() {
+	run<1 << 10>();
+	run<1 << 14>();
+	run<1 << 16>();
+}
@@ -0,0 +1,103 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Measures the throughput of the floating-point conversions of StaticPrintf's parser: %f, %e, %g and %@ compared
+     with the general (normalize/pow10-based) conversions, which remain in use for other types, and with snprintf.
+     Each conversion appends its field to a string, as within a format call.
+     The time a whole "%e"_ConstainerStaticPrintf call takes is given as well.
+     Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. StaticPrintf.cxx */
+
+#include "../StaticPrintf.hxx"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Constainer;
+
+using Printer = detail::Parser<char>;
+
+static std::size_t sink = 0;
+
+template <typename F>
+double nsPerValue( std::vector<double> const& values, F f ) {
+	auto start = std::chrono::steady_clock::now();
+	for (auto v : values)
+		sink += f(v);
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / values.size();
+}
+
+/**< Both paths append the padded field to the output string, as the handlers of the conversions do. */
+static String out;
+
+template <char conversion>
+struct New {
+	std::size_t operator()(double v) const {
+		out.clear();
+		Printer::appendDecimal(out, {}, conversion, v);
+		return out.size();
+	}
+};
+struct FullFormat {
+	std::size_t operator()(double v) const {return "%e"_ConstainerStaticPrintf(v).size();}
+};
+
+template <String (*print)(double)>
+struct Old {
+	std::size_t operator()(double v) const {
+		out.clear();
+		auto field = print(v);
+		Printer::pad_and_reverse(std::true_type{}, field, {});
+		out += field;
+		return out.size();
+	}
+};
+String oldFixed(double v) {return Printer::printFloat<String>(false, {}, v);}
+String oldScientific(double v) {return Printer::printExponential<String>(false, {}, v);}
+String oldGeneral(double v) {return Printer::printFloatHybrid<String>({}, v);}
+
+template <char... format>
+struct Snprintf {
+	std::size_t operator()(double v) const {
+		static constexpr char f[] {'%', format..., '\0'};
+		char buf[512];
+		return std::snprintf(buf, sizeof buf, f, v);
+	}
+};
+
+void run( char const* name, std::vector<double> const& values ) {
+	std::printf("%s:\n", name);
+	double fixed[] {nsPerValue(values, New<'f'>{}), nsPerValue(values, Old<oldFixed>{})},
+	       scientific[] {nsPerValue(values, New<'e'>{}), nsPerValue(values, Old<oldScientific>{})},
+	       general[] {nsPerValue(values, New<'g'>{}), nsPerValue(values, Old<oldGeneral>{})};
+	std::printf("  %%f  %6.1f ns, general path %6.1f ns (%4.1fx), snprintf %6.1f ns\n", fixed[0], fixed[1],
+	            fixed[1] / fixed[0], nsPerValue(values, Snprintf<'f'>{}));
+	std::printf("  %%e  %6.1f ns, general path %6.1f ns (%4.1fx), snprintf %6.1f ns\n", scientific[0], scientific[1],
+	            scientific[1] / scientific[0], nsPerValue(values, Snprintf<'e'>{}));
+	std::printf("  %%g  %6.1f ns, general path %6.1f ns (%4.1fx), snprintf %6.1f ns\n", general[0], general[1],
+	            general[1] / general[0], nsPerValue(values, Snprintf<'g'>{}));
+	std::printf("  %%@  %6.1f ns (shortest),                      snprintf %6.1f ns (%%.17g)\n", nsPerValue(values, New<'@'>{}),
+	            nsPerValue(values, Snprintf<'.', '1', '7', 'g'>{}));
+	std::printf("  \"%%e\"_ConstainerStaticPrintf %.1f ns\n", nsPerValue(values, FullFormat{}));
+}
+
+int main() {
+	std::mt19937_64 rng(42);
+	std::vector<double> uniform(1 << 18), wide(1 << 18), short_decimals(1 << 18);
+	std::uniform_real_distribution<> unit(0, 1);
+	for (auto& v : uniform)
+		v = unit(rng) * 1e6;
+	for (auto& v : wide)
+		v = std::ldexp(unit(rng) + 1, int(rng() % 200) - 100);
+	for (auto& v : short_decimals)
+		v = double(rng() % 1000000) / 100;
+
+	run("Uniform in [0, 1e6)", uniform);
+	run("Exponents in [-100, 100)", wide);
+	run("Two decimal places", short_decimals);
+	return sink == 0;
+}
@@ -0,0 +1,55 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Compares Vector and UninitializedVector on their use as a local buffer of large capacity: creating one,
+     pushing a few elements and destroying it. Vector constructs and destroys its whole capacity each time,
+     UninitializedVector only the elements pushed. Build with e.g. g++ -std=c++1z -O2 -DNDEBUG -I.. UninitializedVector.cxx */
+
+#include "../Vector.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace Constainer;
+
+static std::size_t sink = 0;
+
+/**< Keeps the compiler from eliding the construction of the vectors, whose address is stored here. */
+static void const* volatile escape = nullptr;
+
+/**< Nanoseconds per creation of a Vec, followed by pushing count copies of value. */
+template <typename Vec>
+double nsPerFill( typename Vec::value_type const& value, std::size_t count, int repetitions = 1 << 14 ) {
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; ++r) {
+		Vec vec;
+		escape = &vec;
+		for (std::size_t i = 0; i != count; ++i)
+			vec.push_back(value);
+		sink += vec.size();
+	}
+	std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+	return d.count() / repetitions;
+}
+
+template <typename T, std::size_t N>
+void run( char const* type, T const& value, std::size_t count ) {
+	double tv = nsPerFill<Vector<T, N>>(value, count),
+	       tu = nsPerFill<UninitializedVector<T, N>>(value, count);
+	std::printf("%-12s capacity %5zu, %4zu pushed: Vector %9.1f ns, UninitializedVector %7.1f ns (%.0fx)\n",
+	            type, N, count, tv, tu, tv / tu);
+}
+
+int main() {
+	// Short strings are copied without allocating, long ones allocate on every push
+	std::string const word = "word", text = "a string beyond the small string optimisation";
+	run<int,         256>("int", 42, 16);
+	run<int,        4096>("int", 42, 16);
+	run<std::string, 256>("short string", word, 16);
+	run<std::string, 4096>("short string", word, 16);
+	run<std::string, 4096>("long string", text, 16);
+	run<std::string, 4096>("long string", text, 1024);
+	return sink == 0;
+}
@@ -0,0 +1,68 @@
+#!/bin/sh
+# Copyright 2015, 2016 Robert Haberlach
+#	Distributed under the Boost Software License, Version 1.0.
+#	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+#
+# Compiles CompileTime.cxx for every benchmark area and each N given (default: 64 256 1024), and prints the
+# compilation time and, with --steps, the constexpr operation limit the evaluation needs, found by bisection over
+# -fconstexpr-ops-limit (GCC) or -fconstexpr-steps (Clang) to within 1/8.
+# Usage: [CXX=clang++] [CXXFLAGS=...] ./compile_time.sh [--steps] [N...]
+
+cd "$(dirname "$0")" || exit 1
+
+CXX=${CXX:-g++}
+if $CXX --version | grep -qi clang; then
+	limit_flag=-fconstexpr-steps
+	unlimited="-fconstexpr-steps=2147483647"
+else
+	limit_flag=-fconstexpr-ops-limit
+	unlimited="-fconstexpr-ops-limit=4398046511104 -fconstexpr-loop-limit=2147483647"
+fi
+
+steps=
+if [ "$1" = "--steps" ]; then
+	steps=1
+	shift
+fi
+sizes=${*:-64 256 1024}
+
+# Compiles the area $1 with N = $2 and the further flags $3; succeeds iff the compilation does.
+build() {
+	$CXX -std=c++1z -fsyntax-only -I.. $CXXFLAGS ${1:+-DBENCHMARK_$1} -DBENCHMARK_N=$2 $3 CompileTime.cxx 2>/dev/null
+}
+
+now() {
+	date +%s%N
+}
+
+# The smallest limit (to within 1/8) with which area $1 compiles for N = $2.
+required_steps() {
+	low=0 high=1024
+	until build "$1" "$2" "$limit_flag=$high"; do
+		low=$high high=$((high * 2))
+		[ $high -gt 4398046511104 ] && { echo "> 2^42"; return; }
+	done
+	while [ $((high - low)) -gt $((high / 8)) ]; do
+		mid=$(((low + high) / 2))
+		if build "$1" "$2" "$limit_flag=$mid"; then high=$mid; else low=$mid; fi
+	done
+	echo "$high"
+}
+
+start=$(now)
+build "" 0 "$unlimited" || { echo "CompileTime.cxx does not compile with $CXX" >&2; exit 1; }
+headers=$((($(now) - start) / 1000000))
+echo "Headers only: $headers ms; the times below include them."
+
+for area in VECTOR FLATMAP STABLEVECTOR CHUNKPOOL BITSET PRINTF; do
+	for n in $sizes; do
+		start=$(now)
+		if build "$area" "$n" "$unlimited"; then
+			line=$(printf "%-13s N = %-6s %7d ms" "$area" "$n" $((($(now) - start) / 1000000)))
+			[ -n "$steps" ] && line="$line, $(required_steps "$area" "$n") constexpr operations"
+			echo "$line"
+		else
+			printf "%-13s N = %-6s failed\n" "$area" "$n"
+		fi
+	done
+done
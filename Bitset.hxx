@@ -6,6 +6,7 @@
 
 #include "Algorithms.hxx"
 #include "Math.hxx"
+#include "RangeAccess.hxx"
 #include "String.hxx"
 
 namespace Constainer {
@@ -44,6 +45,31 @@ class Bitset {
 		_storage.back() &= _mask_chunkof(size()) - 1;
 	}
 
+	struct _and_not {
+		constexpr STD::uint64_t operator()(STD::uint64_t c, STD::uint64_t m) const {return c & ~m;}
+	};
+
+	/**< Replaces every chunk c overlapping [pos1, pos2] by op(c, m), where m masks the bits in the range. */
+	template <typename Op>
+	constexpr void _apply_range(size_type pos1, size_type pos2, Op op) {
+		assert(pos1 <= pos2 && pos2 < size());
+		auto first = pos1/_bits_per_chunk, last = pos2/_bits_per_chunk;
+		auto lo = ~(_mask_chunkof(pos1) - 1), // Bits at or above pos1
+		     hi = _mask_chunkof(pos2)*2 - 1;  // Bits at or below pos2
+		if (first == last)
+			_storage[first] = op(_storage[first], lo & hi);
+		else {
+			_storage[first] = op(_storage[first], lo);
+			for (auto i = first+1; i != last; ++i)
+				_storage[i] = op(_storage[i], _full_mask);
+			_storage[last] = op(_storage[last], hi);
+		}
+	}
+
+	constexpr STD::uint64_t _chunk_matching(size_type i, bool value) const {
+		return value? _storage[i] : ~_storage[i];
+	}
+
 
 public:
 
@@ -114,10 +140,12 @@ public:
 		_set(pos, value);
 		return *this;
 	}
+	/**< Sets the bits in the closed range [pos1, pos2] to value. */
 	constexpr Bitset& set(size_type pos1, size_type pos2, bool value = true) {
-	    // TODO: This can be made a good lot more efficient, and you know how.
-		while (pos1 != pos2+1)
-            set(pos1++, value);
+		if (value)
+			_apply_range(pos1, pos2, STD::bit_or<>());
+		else
+			_apply_range(pos1, pos2, _and_not());
 		return *this;
 	}
 
@@ -132,6 +160,10 @@ public:
 		_flip(pos);
 		return *this;
 	}
+	constexpr Bitset& flip(size_type pos1, size_type pos2) {
+		_apply_range(pos1, pos2, STD::bit_xor<>());
+		return *this;
+	}
 
 	constexpr Bitset& reset() {
 		Constainer::fill(Constainer::begin(_storage), Constainer::end(_storage), 0);
@@ -142,16 +174,40 @@ public:
 		_reset(pos);
 		return *this;
 	}
+	constexpr Bitset& reset(size_type pos1, size_type pos2) {
+		_apply_range(pos1, pos2, _and_not());
+		return *this;
+	}
 
-	constexpr size_type leading(bool value) const {
-		STD::size_t count = 0;
-		for (auto& c : _storage) {
-			auto v = value? ~c : c;
-			if (v != 0)
-				return STD::min<size_type>(size(), count++*_bits_per_chunk + count_trailing(v));
+	/**< The position of the first bit at or after pos that equals value, or size() if there is none. */
+	constexpr size_type find_next(size_type pos, bool value) const {
+		if (pos >= size())
+			return size();
+		auto i = pos/_bits_per_chunk;
+		auto v = _chunk_matching(i, value) & ~(_mask_chunkof(pos) - 1);
+		while (v == 0) {
+			if (++i == _storage.size())
+				return size();
+			v = _chunk_matching(i, value);
 		}
+		return STD::min<size_type>(size(), i*_bits_per_chunk + count_trailing(v));
+	}
+	/**< The position of the last bit at or before pos that equals value, or size() if there is none. */
+	constexpr size_type find_prev(size_type pos, bool value) const {
+		assert(pos < size());
+		auto i = pos/_bits_per_chunk;
+		auto v = _chunk_matching(i, value) & (_mask_chunkof(pos)*2 - 1);
+		while (v == 0) {
+			if (i-- == 0)
+				return size();
+			v = _chunk_matching(i, value);
+		}
+		return i*_bits_per_chunk + _bits_per_chunk-1 - count_leading(v);
+	}
 
-		return size();
+	/**< The number of consecutive bits equal to value at the start of the set. */
+	constexpr size_type leading(bool value) const {
+		return find_next(0, !value);
 	}
 
 	template <typename CharT = char, STD::size_t MaxN = N,
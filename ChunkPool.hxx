@@ -5,10 +5,108 @@
 #pragma once
 
 #include "Array.hxx"
-#include "Bitset.hxx"
+#include "Math.hxx"
+
+#include "impl/Stats.hxx"
 
 namespace Constainer {
 
+namespace detail {
+	/**< Records which of N slots are in use. Above the bit per slot sits a summary with a bit per word,
+	     set iff that word is full, and so on recursively up to a single word. Finding a free slot thus
+	     takes one word operation per level, i.e. a constant number for any practical N. */
+	template <STD::size_t N, bool = (N > 64)>
+	class UsageBitmap {
+		using size_type = STD::size_t;
+
+		static constexpr size_type _words = (N+63)/64;
+
+		Array<STD::uint64_t, _words> _bits {};
+		UsageBitmap<_words> _full;
+
+		CONSTAINER_PURE_CONST static constexpr STD::uint64_t _word_mask(size_type w) {
+			return w+1 == _words && N%64 != 0? (1ull << N%64) - 1 : -1;
+		}
+
+	public:
+		constexpr bool test(size_type i) const {return _bits[i/64] >> i%64 & 1;}
+		constexpr bool all() const {return _full.all();}
+
+		constexpr void set(size_type i) {
+			auto& w = _bits[i/64];
+			w |= 1ull << i%64;
+			if (w == _word_mask(i/64))
+				_full.set(i/64);
+		}
+		constexpr void reset(size_type i) {
+			_bits[i/64] &= ~(1ull << i%64);
+			_full.reset(i/64);
+		}
+		constexpr void reset() {
+			_bits.fill(0);
+			_full.reset();
+		}
+
+		/**< The first unset bit, or N if all are set. */
+		constexpr size_type first_unset() const {
+			auto w = _full.first_unset();
+			if (w == _words)
+				return N;
+			countStat(&Stats::probes);
+			return w*64 + count_trailing(~_bits[w]);
+		}
+
+		/**< Sets the first k unset bits, of which there must be as many, and calls f with each index.
+		     Takes over a whole word of free slots at a time. */
+		template <typename F>
+		constexpr void set_first_unset(size_type k, F f) {
+			while (k != 0) {
+				auto w = _full.first_unset();
+				AssertExcept<STD::bad_alloc>(w != _words);
+				countStat(&Stats::probes);
+				auto free = ~_bits[w] & _word_mask(w);
+				for (; k != 0 && free != 0; --k, free &= free-1)
+					f(w*64 + count_trailing(free));
+				_bits[w] = _word_mask(w) & ~free;
+				if (free == 0)
+					_full.set(w);
+			}
+		}
+	};
+
+	template <STD::size_t N>
+	class UsageBitmap<N, false> {
+		using size_type = STD::size_t;
+
+		static constexpr STD::uint64_t _mask = N == 64? -1 : (1ull << N) - 1;
+
+		STD::uint64_t _bits = 0;
+
+	public:
+		constexpr bool test(size_type i) const {return _bits >> i & 1;}
+		constexpr bool all() const {return _bits == _mask;}
+
+		constexpr void set  (size_type i) {_bits |=   1ull << i;}
+		constexpr void reset(size_type i) {_bits &= ~(1ull << i);}
+		constexpr void reset() {_bits = 0;}
+
+		constexpr size_type first_unset() const {
+			countStat(&Stats::probes);
+			return all()? N : count_trailing(~_bits);
+		}
+
+		template <typename F>
+		constexpr void set_first_unset(size_type k, F f) {
+			if (k != 0)
+				countStat(&Stats::probes);
+			for (auto free = ~_bits & _mask; k != 0; --k, free &= free-1) {
+				f(count_trailing(free));
+				_bits |= free & -free;
+			}
+		}
+	};
+}
+
 template <typename T, STD::size_t N>
 class ChunkPool : private Array<T, N> {
 
@@ -29,36 +127,55 @@ public:
 	static constexpr size_type max_size() {return _base::size();}
 
 private:
-	Bitset<N> _used;
+	detail::UsageBitmap<N> _used;
+	size_type _used_count = 0;
+
+	template <typename OutputIt>
+	struct _slot_writer {
+		pointer data;
+		OutputIt* out;
+		constexpr void operator()(size_type i) const {*(*out)++ = data + i;}
+	};
 
 public:
 
 	constexpr ChunkPool() : _base{}, _used{} {}
 
 	constexpr size_type used() const {
-		return _used.count();
+		return _used_count;
 	}
 
 	constexpr bool available() const {
 		return !_used.all();
 	}
 
+	/**< The slot is not reinitialised; it holds whatever object was last stored in it. */
 	constexpr pointer grab() {
-		auto pos = _used.leading(1);
+		auto pos = _used.first_unset();
 		AssertExcept<STD::bad_alloc>(pos != this->size());
 		_used.set(pos);
-		auto& ref = _base::operator[](pos);
-		ref = value_type();
-		return &ref;
+		++_used_count;
+		return &_base::operator[](pos);
+	}
+
+	/**< Grabs n slots at once and writes pointers to them to out. Either all or none are grabbed. */
+	template <typename OutputIt>
+	constexpr OutputIt grab_n(size_type n, OutputIt out) {
+		AssertExcept<STD::bad_alloc>(n <= max_size() - used());
+		_used.set_first_unset(n, _slot_writer<OutputIt>{_base::data(), &out});
+		_used_count += n;
+		return out;
 	}
 
 	constexpr void free() {
 		_used.reset();
+		_used_count = 0;
 	}
 	constexpr void free( const_pointer p ) {
 		auto i = p-_base::data();
 		assert( _used.test(i) );
 		_used.reset(i);
+		--_used_count;
 	}
 };
 
@@ -0,0 +1,211 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "FlatMap.hxx"
+#include "FlatSet.hxx"
+#include "Math.hxx"
+
+#include <initializer_list>
+
+namespace Constainer { namespace detail {
+
+/**< A read-only companion of FlatUniqueTree, holding the elements in Eytzinger order: the sorted
+     sequence is laid out as an implicit binary search tree in breadth first order, node k having
+     its children at 2k and 2k+1. A search therefore touches the first levels in a few adjacent
+     cache lines, and descends without any branch depending on the comparison.
+     Iteration visits the elements in layout order, not in sorted order. */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, STD::size_t N>
+class EytzingerTree : private ValueComparator<Compare, Value, KeyOfValue> {
+	// Node indices start at one, which makes the child and parent computations trivial
+	using _storage_type = Array<Value, N+1>;
+
+public:
+	using key_type = Key;
+	using key_compare = Compare;
+	using value_type = Value;
+	using value_compare = ValueComparator<key_compare, value_type, KeyOfValue>;
+
+	using size_type       = typename _storage_type::size_type;
+	using difference_type = typename _storage_type::difference_type;
+	using reference       = STD::conditional_t<STD::is_same<Key, Value>{}, typename _storage_type::const_reference,
+	                                                                       typename _storage_type::reference>;
+	using const_reference = typename _storage_type::const_reference;
+	using pointer         = STD::conditional_t<STD::is_same<Key, Value>{}, typename _storage_type::const_pointer,
+	                                                                       typename _storage_type::pointer>;
+	using const_pointer   = typename _storage_type::const_pointer;
+	using iterator        = pointer;
+	using const_iterator  = const_pointer;
+
+private:
+	_storage_type _values {};
+	size_type _size = 0;
+
+	using _const_iter_pair = STD::pair<const_iterator, const_iterator>;
+
+	constexpr key_compare const& _key_comp() const {return *this;}
+
+	/**< Assigns the sorted range starting at it to the subtree rooted at k by in-order traversal. */
+	template <typename InputIt>
+	constexpr InputIt _fill(InputIt it, size_type k) {
+		if (k <= _size) {
+			it = _fill(it, 2*k);
+			_values[k] = *it++;
+			it = _fill(it, 2*k+1);
+		}
+		return it;
+	}
+
+	template <typename InputIt>
+	constexpr void _assign(InputIt first, InputIt last) {
+		auto n = Constainer::distance(first, last);
+		AssertExcept<STD::bad_alloc>(n >= 0 && static_cast<size_type>(n) <= max_size());
+		_size = n;
+		_fill(first, 1);
+	}
+
+	/**< Every node descended through appends one bit to k, set iff the search went right. The result is
+	     the last node where it went left, found by stripping the trailing ones and one more bit. */
+	CONSTAINER_PURE_CONST static constexpr size_type _last_left_turn(size_type k) {
+		return k >> (count_trailing(~k) + 1);
+	}
+
+	constexpr const_iterator _node(size_type k) const {
+		return k == 0? end() : _values.begin() + k;
+	}
+
+	template <typename T>
+	constexpr const_iterator _lower_bound(T const& key) const {
+		size_type k = 1;
+		while (k <= _size)
+			k = 2*k + _key_comp()(KeyOfValue()(_values[k]), key);
+		return _node(_last_left_turn(k));
+	}
+	template <typename T>
+	constexpr const_iterator _upper_bound(T const& key) const {
+		size_type k = 1;
+		while (k <= _size)
+			k = 2*k + !_key_comp()(key, KeyOfValue()(_values[k]));
+		return _node(_last_left_turn(k));
+	}
+	template <typename T>
+	constexpr const_iterator _find(T const& key) const {
+		auto i = _lower_bound(key), last = end();
+		return i == last || _key_comp()(key, KeyOfValue()(*i))? last : i;
+	}
+
+	constexpr iterator _remcv(const_iterator i) {return const_cast<iterator>(i);}
+
+public:
+	constexpr EytzingerTree() : value_compare{} {}
+
+	template <typename Container>
+	constexpr explicit EytzingerTree(FlatUniqueTree<Key, Value, KeyOfValue, Compare, Container> const& tree)
+		: value_compare(tree.key_comp()) {
+		_assign(tree.begin(), tree.end());
+	}
+
+	template <typename InputIt>
+	constexpr EytzingerTree(ordered_unique_range_t, InputIt first, InputIt last, key_compare const& comp = {})
+		: value_compare(comp) {
+		_assign(first, last);
+	}
+	template <typename InputIt>
+	constexpr EytzingerTree(InputIt first, InputIt last, key_compare const& comp = {})
+		: EytzingerTree(FlatUniqueTree<Key, Value, KeyOfValue, Compare, Vector<Value, N>>(first, last, comp)) {}
+
+	constexpr EytzingerTree(STD::initializer_list<value_type> ilist, key_compare const& comp = {})
+		: EytzingerTree(ilist.begin(), ilist.end(), comp) {}
+	constexpr EytzingerTree(ordered_unique_range_t, STD::initializer_list<value_type> ilist, key_compare const& comp = {})
+		: EytzingerTree(ordered_unique_range, ilist.begin(), ilist.end(), comp) {}
+
+	constexpr   key_compare   key_comp() const {return *this;}
+	constexpr value_compare value_comp() const {return *this;}
+
+	constexpr         bool empty() const {return _size == 0;}
+	constexpr size_type     size() const {return _size;}
+	static constexpr size_type max_size() {return N;}
+
+	constexpr       iterator  begin()       {return _values.begin() + 1;}
+	constexpr       iterator    end()       {return begin() + _size;}
+	constexpr const_iterator  begin() const {return _values.begin() + 1;}
+	constexpr const_iterator    end() const {return begin() + _size;}
+	constexpr const_iterator cbegin() const {return begin();}
+	constexpr const_iterator   cend() const {return end();}
+
+	/**< The element following i in sorted order, or end(). */
+	constexpr const_iterator successor(const_iterator i) const {
+		size_type k = i - _values.begin();
+		if (2*k+1 <= _size)
+			for (k = 2*k+1; 2*k <= _size;)
+				k *= 2;
+		else
+			k = _last_left_turn(k);
+		return _node(k);
+	}
+	constexpr iterator successor(const_iterator i) {return _remcv(as_const(*this).successor(i));}
+
+	constexpr const_iterator lower_bound(key_type const& key) const {return _lower_bound(key);}
+	constexpr       iterator lower_bound(key_type const& key)       {return _remcv(_lower_bound(key));}
+	template <typename T>
+	constexpr has_is_transparent<key_compare, const_iterator> lower_bound(T const& t) const {return _lower_bound(t);}
+	template <typename T>
+	constexpr has_is_transparent<key_compare,       iterator> lower_bound(T const& t)       {return _remcv(_lower_bound(t));}
+
+	constexpr const_iterator upper_bound(key_type const& key) const {return _upper_bound(key);}
+	constexpr       iterator upper_bound(key_type const& key)       {return _remcv(_upper_bound(key));}
+	template <typename T>
+	constexpr has_is_transparent<key_compare, const_iterator> upper_bound(T const& t) const {return _upper_bound(t);}
+	template <typename T>
+	constexpr has_is_transparent<key_compare,       iterator> upper_bound(T const& t)       {return _remcv(_upper_bound(t));}
+
+	constexpr const_iterator find(key_type const& key) const {return _find(key);}
+	constexpr       iterator find(key_type const& key)       {return _remcv(_find(key));}
+	template <typename T>
+	constexpr has_is_transparent<key_compare, const_iterator> find(T const& t) const {return _find(t);}
+	template <typename T>
+	constexpr has_is_transparent<key_compare,       iterator> find(T const& t)       {return _remcv(_find(t));}
+
+	constexpr _const_iter_pair equal_range(key_type const& key) const {return {_lower_bound(key), _upper_bound(key)};}
+	template <typename T>
+	constexpr has_is_transparent<key_compare, _const_iter_pair> equal_range(T const& t) const {
+		return {_lower_bound(t), _upper_bound(t)};
+	}
+
+	constexpr size_type count(key_type const& key) const {return _find(key) != end();}
+	template <typename T>
+	constexpr has_is_transparent<key_compare, size_type> count(T const& t) const {return _find(t) != end();}
+};
+}
+
+template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>>
+using EytzingerSet = detail::EytzingerTree<T, T, IdentityFunctor, Compare, MaxN>;
+
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>>
+class EytzingerMap : public detail::EytzingerTree<K, ConstKeyPair<K, V>, typename ConstKeyPair<K, V>::KeyOfPair, Compare, MaxN> {
+	using _base = detail::EytzingerTree<K, ConstKeyPair<K, V>, typename ConstKeyPair<K, V>::KeyOfPair, Compare, MaxN>;
+
+public:
+	using _base::_base;
+
+	using mapped_type = V;
+
+	using typename _base::key_type;
+	using typename _base::reference;
+	using typename _base::const_reference;
+
+	constexpr       reference at(key_type const& key) {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->end(), "");
+		return *pos;
+	}
+	constexpr const_reference at(key_type const& key) const {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->cend(), "");
+		return *pos;
+	}
+};
+
+}
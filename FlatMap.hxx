@@ -13,7 +13,7 @@ namespace Constainer {
 	class ConstKeyPair : public TotallyOrdered<ConstKeyPair<Key, Value>> {
 		using _base = STD::tuple<Key, Value>;
 
-		Key _key; Value _value;
+		Key _key {}; Value _value {};
 
 		template <typename, typename>
 		friend class ConstKeyPair;
@@ -87,12 +87,10 @@ public:
 		constexpr value_type      && value()      && {return STD::move(_value);}
 		constexpr value_type const&& value() const&& {return STD::move(_value);}
 
-		template <typename K, typename V>
-		friend constexpr bool operator==(ConstKeyPair<K, V> const& lhs, ConstKeyPair<K, V> const& rhs) {
+		friend constexpr bool operator==(ConstKeyPair const& lhs, ConstKeyPair const& rhs) {
 			return lhs.key() == rhs.key() && lhs.value() == rhs.value();
 		}
-		template <typename K, typename V>
-		friend constexpr bool operator <(ConstKeyPair<K, V> const& lhs, ConstKeyPair<K, V> const& rhs) {
+		friend constexpr bool operator <(ConstKeyPair const& lhs, ConstKeyPair const& rhs) {
 			return lhs.key()<rhs.key() || lhs.value()<rhs.value();
 		}
 	};
@@ -102,7 +100,7 @@ CONSTAINER_DIAGNOSTIC_PUSH
 CONSTAINER_DIAGNOSTIC_IGNORE("-Wmismatched-tags")
 namespace std {
 	template <typename K, typename V>
-	struct tuple_size<Constainer::ConstKeyPair<K, V>> : STD::integral_constant<STD::size_t, 2> {};
+	struct tuple_size<Constainer::ConstKeyPair<K, V>> : Constainer::STD::integral_constant<Constainer::STD::size_t, 2> {};
 
 	template <typename K, typename V>
 	struct tuple_element<0, Constainer::ConstKeyPair<K, V>> {using type = K;};
@@ -45,6 +45,13 @@ namespace detail {
 		}
 	};
 
+/**< Primary overload. Containers whose iterators have to keep referring to the same elements
+     (i.e. BasicStableVector) should overload this to permute their nodes instead of the values. */
+template <typename Container, typename Iterator, typename Compare>
+constexpr void inplaceMerge( Container&, Iterator first, Iterator middle, Iterator last, Compare comp ) {
+	Constainer::inplace_merge(first, middle, last, comp);
+}
+
 template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container>
 class FlatTree : private ValueComparator<Compare, Value, KeyOfValue>
 {
@@ -144,17 +151,11 @@ public:
 	explicit FlatTree( value_compare const& comp ) : value_compare(comp) {}
 
 	template <bool Unique, typename InputIt>
-	constexpr FlatTree( STD::bool_constant<Unique>, InputIt first, InputIt last,
+	constexpr FlatTree( STD::integral_constant<bool, Unique> u, InputIt first, InputIt last,
 	                    value_compare const& comp)
 		: value_compare(comp)
 	{
-		// More efficient assuming [first, last) is sorted to some extent
-		if(Unique)
-			while (first != last)
-				insert_unique(this->cend(), *first++);
-		else
-			while (first != last)
-				insert_equal (this->cend(), *first++);
+		_insert_range(u, false, first, last);
 	}
 
 	template <typename InputIt>
@@ -324,61 +325,25 @@ public:
 			return _inject(ret.first, STD::move(val));
 		return unconstifyIterator(_container, ret.first);
 	}
-private:
-	template <typename InputIt>
-	constexpr void _insert_unique(ordered_unique_range_t, InputIt first, InputIt last, STD::input_iterator_tag) {
-		auto pos = end();
-		for (; first != last; ++first) {
-			pos = insert_unique(pos, *first).first;
-			++pos;
-		}
-	}
-
-	template <typename BiDirIt>
-	constexpr void _insert_unique(ordered_unique_range_t, BiDirIt first, BiDirIt last, STD::bidirectional_iterator_tag) {
-		_insert_ordered_range(STD::true_type{}, first, last);
-	}
-
-public:
 
 	template <typename InputIt>
 	constexpr void insert_unique(InputIt first, InputIt last) {
-		while (first != last)
-			insert_unique(*first++);
+		_insert_range(STD::true_type{}, false, first, last);
 	}
 
 	template <typename InputIt>
 	constexpr void insert_unique(ordered_unique_range_t, InputIt first, InputIt last) {
-		_insert_unique(ordered_unique_range, first, last, iteratorCategory<InputIt>{});
+		_insert_range(STD::true_type{}, true, first, last);
 	}
 
 	template <typename InputIt>
 	constexpr void insert_equal(InputIt first, InputIt last) {
-		while (first != last)
-			insert_equal(*first++);
-	}
-
-private:
-	template <typename InputIt>
-	constexpr void _insert_equal(ordered_range_t, InputIt first, InputIt last, STD::input_iterator_tag) {
-		auto pos = end();
-		while (first != last) {
-			// Potential performance boost if several elements can be inserted adjacently
-			pos = insert_equal(pos, *first++);
-			++pos;
-		}
-	}
-
-	template <typename BiDirIt>
-	constexpr void _insert_equal(ordered_range_t, BiDirIt first, BiDirIt last, STD::bidirectional_iterator_tag) {
-		insert_ordered_range(false, first, last);
+		_insert_range(STD::false_type{}, false, first, last);
 	}
 
-public:
-
 	template <typename InputIt>
 	constexpr void insert_equal(ordered_range_t, InputIt first, InputIt last) {
-		_insert_equal(ordered_range, first, last, iteratorCategory<InputIt>{});
+		_insert_range(STD::false_type{}, true, first, last);
 	}
 
 	template <typename... Args>
@@ -416,6 +381,7 @@ protected:
 		while (count > 0) {
 			auto intervall_size = count / 2;
 			auto it = first + intervall_size;
+			detail::countStat(&Stats::comparisons);
 			if (cmp(KeyOfValue()(*it), key)) {
 				first = ++it;
 				count -= intervall_size + 1;
@@ -432,6 +398,7 @@ protected:
 		while (count > 0) {
 			auto intervall_size = count / 2;
 			auto it = first + intervall_size;
+			detail::countStat(&Stats::comparisons);
 			if (not cmp(key, KeyOfValue()(*it))) {
 				first = ++it;
 				count -= intervall_size + 1;
@@ -557,59 +524,55 @@ protected:
 		return {pos, pos};
 	}
 
-	/**< The following algorithm was taken from boost::container::flat_tree<>::priv_insert_ordered_range. */
-	template <bool Unique, typename BiDirIt>
-	constexpr void _insert_ordered_range(STD::bool_constant<Unique>, BiDirIt first, BiDirIt last)
-	{
-		size_type len = Constainer::distance(first, last), BurstSize=len;
-		//Auxiliary data for insertion positions.
-		Constainer::Vector<size_type, max_size()> positions(len);
-		auto b = begin(), pos = b, ce = end();
+	/**< Sorts the elements in [begin()+n, end()) unless they are known to be ordered, and merges them
+	     into the ordered elements in front of them. The unique variant first drops every element whose key
+	     is already present, either among the new elements or in [begin(), begin()+n), so that as with
+	     insert_unique, the first element inserted with a given key wins.
+	     This is O(M log M + N log N) instead of the O(M*N) of M individual insertions. */
+	template <bool Unique>
+	constexpr void _merge_tail(STD::integral_constant<bool, Unique>, size_type n, bool ordered) {
 		auto const& val_cmp = _val_comp();
-		//Loop in burst sizes
-		bool back_insert = false;
-		while (len != 0 && not back_insert) {
-			auto burst = STD::min(len, BurstSize);
-			size_type unique_burst = 0, checked = 0;
-			for(; checked != burst; ++checked) {
-				//Get the insertion position for each key
-				auto const& val = *first;
-				pos = _lower_bound(pos, ce, KeyOfValue()(val));
-				//Check if already present
-				if (pos != ce) {
-					++first;
-					--len;
-					if (Unique && !val_cmp(val, *pos))
-						positions[checked] = size_type(-1);
-					else {
-						++unique_burst;
-						positions[checked] = pos - b;
-					}
-				}
-				else { //this element and the remaining should be back inserted
-					back_insert = true;
-					break;
-				}
-			}
-			if (unique_burst != 0) {
-				AssertExcept<STD::bad_alloc>(max_size() - size() >= unique_burst);
-				insert_ordered_at(_container, unique_burst, first, positions.begin() + checked);
-				pos += unique_burst;
+		auto first = begin(), middle = first + n, last = end();
+		if (not ordered)
+			// Elements with equivalent keys have to retain their order of insertion: the multi variant keeps
+			// all of them in that order, the unique one only the first
+			Constainer::stable_sort(middle, last, val_cmp);
+		if (Unique) {
+			// Compact the survivors towards middle. As the tail is sorted, so are the lower bounds.
+			auto out = middle, pos = first;
+			for (auto it = middle; it != last; ++it) {
+				if (out != middle && not val_cmp(*Constainer::prev(out), *it))
+					continue;
+				pos = _lower_bound(pos, middle, KeyOfValue()(*it));
+				if (pos != middle && not val_cmp(*it, *pos))
+					continue;
+				if (out != it)
+					*out = STD::move(*it);
+				++out;
 			}
+			_container.erase(out, last);
 		}
-		//The remaining range should be back inserted
-		if (len != 0) {
-			if(Unique)
-				do {
-					auto next = Constainer::next(first);
-					auto const& val = *first;
-					if (next == last || val_cmp(val, *next))
-						_container.push_back(val);
-
-					first = next;
-				} while (--len != 0);
-			else
-				_container.insert(end(), len, first);
+
+		inplaceMerge(_container, first, middle, end(), val_cmp);
+	}
+
+	/**< Stages [first, last) at the end of the container in bursts that fill the remaining capacity,
+	     each followed by _merge_tail. Only once the container is full are elements inserted one by one,
+	     so duplicates of present keys are still ignored rather than reported as overflowing. */
+	template <bool Unique, typename InputIt>
+	constexpr void _insert_range(STD::integral_constant<bool, Unique> u, bool ordered, InputIt first, InputIt last) {
+		while (first != last) {
+			auto n = size();
+			if (n == max_size()) {
+				if (Unique)
+					insert_unique(value_type(*first++));
+				else
+					insert_equal(value_type(*first++));
+				continue;
+			}
+			do _container.emplace_back(*first++);
+			while (first != last && size() != max_size());
+			_merge_tail(u, n, ordered);
 		}
 	}
 };
@@ -30,25 +30,39 @@ template <typename InputIt>
 constexpr auto distance( InputIt first, InputIt last )
 { return detail::distance(first, last, typename STD::iterator_traits<InputIt>::iterator_category{}); }
 
+namespace detail {
+	template <typename RandomIt>
+	constexpr void advance( RandomIt& it, typename STD::iterator_traits<RandomIt>::difference_type n,
+	                        STD::random_access_iterator_tag )
+	{ it += n; }
+
+	template <typename InputIt>
+	constexpr void advance( InputIt& it, typename STD::iterator_traits<InputIt>::difference_type n,
+	                        STD::input_iterator_tag )
+	{
+		if (n < 0)
+			do --it;
+			while (++n);
+		else
+			while (n-- > 0)
+				++it;
+	}
+}
+
 template <typename InputIt>
 constexpr void advance( InputIt& it, typename STD::iterator_traits<InputIt>::difference_type n ) {
-	if (n < 0)
-		do --it;
-		while (++n);
-	else
-		while (n-- > 0)
-			++it;
+	detail::advance(it, n, typename STD::iterator_traits<InputIt>::iterator_category{});
 }
 
 template <typename InputIt>
 constexpr auto next( InputIt it, typename STD::iterator_traits<InputIt>::difference_type n=1 ) {
-	advance(it, n);
+	Constainer::advance(it, n);
 	return it;
 }
 
 template <typename InputIt>
 constexpr auto prev( InputIt it, typename STD::iterator_traits<InputIt>::difference_type n=1 ) {
-	return next(it, -n);
+	return Constainer::next(it, -n);
 }
 
 namespace detail {
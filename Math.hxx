@@ -132,6 +132,19 @@ CONSTAINER_PURE_CONST constexpr unsigned count_trailing( STD::uint64_t v ) {
 	#endif
 }
 
+/**< v must not be zero. */
+CONSTAINER_PURE_CONST constexpr unsigned count_leading( STD::uint64_t v ) {
+	#if defined __clang__ || defined __GNUG__
+		return __builtin_clzll(v);
+	#else
+		unsigned n = 0;
+		for (unsigned shift = 32; shift != 0; shift /= 2)
+			if (!(v >> (64 - shift - n)))
+				n += shift;
+		return n;
+	#endif
+}
+
 /**< Obtains the fractional part of r by subtracting powers of two. */
 template <typename Real>
 CONSTAINER_PURE_CONST constexpr Real fractional (Real r)
@@ -5,7 +5,11 @@
 #pragma once
 
 #include "String.hxx"
+#include "Vector.hxx"
 #include "Math.hxx"
+#include "impl/FloatParsing.hxx"
+
+#include <cstring> // memcpy
 
 namespace Constainer {
 
@@ -18,10 +22,39 @@ struct ParserState {
 
 namespace detail {
 
+	template <typename=void>
+	struct DigitValues {
+		/**< The value of the digit with the given ASCII code in bases up to 36, or 0xFF for non-digits. */
+		static constexpr STD::uint8_t value[128] {
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			  0,   1,   2,   3,   4,   5,   6,   7,   8,   9, 255, 255, 255, 255, 255, 255,
+			255,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+			 25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35, 255, 255, 255, 255, 255,
+			255,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+			 25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35, 255, 255, 255, 255, 255,
+		};
+	};
+	template <typename T> constexpr STD::uint8_t DigitValues<T>::value[128];
+
+	/**< The value of c as a digit in bases up to 36, letters being case-insensitive, or 0xFF if it isn't one. */
+	template <typename CharT>
+	constexpr unsigned digitValue(CharT c) {
+		return static_cast<STD::make_unsigned_t<CharT>>(c) < 128?
+		         DigitValues<>::value[static_cast<STD::make_unsigned_t<CharT>>(c)] : 0xFF;
+	}
+
+	template <typename CharT>
+	constexpr bool isSpace(CharT c) {
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
 	template <typename InputIt>
 	constexpr InputIt skipWS(InputIt first, InputIt last) {
-		String whitespace = " \t\n\f\v\r";
-		return Constainer::find_first_not_of(first, last, whitespace.begin(), whitespace.end());
+		while (first != last && isSpace(*first))
+			++first;
+		return first;
 	}
 
 	template <typename Arithmetic, typename InputIt>
@@ -37,6 +70,48 @@ namespace detail {
 
 		return 1;
 	}
+
+	/**< Whether the eight characters at first are decimal digits, in which case their value is stored in value and
+	     first is advanced past them. Only pointers to octets are read that way, as one word validated and converted with SWAR arithmetic,
+	     and only at runtime on little-endian targets; otherwise this always fails, leaving the work to the caller. */
+	template <typename InputIt>
+	constexpr bool loadEightDigits( InputIt&, InputIt, STD::uint64_t& ) {return false;}
+
+	template <typename CharT, typename = require<STD::integral_constant<bool, sizeof(CharT) == 1>>>
+	constexpr bool loadEightDigits( CharT*& first, CharT* last, STD::uint64_t& value ) {
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		if (isConstantEvaluated() || last - first < 8)
+			return false;
+		STD::uint64_t v = 0;
+		STD::memcpy(&v, first, 8);
+		// Adding 0x46 carries into the top bit of each byte greater than '9', subtracting 0x30 borrows from it for each
+		// one less than '0'
+		if ((((v + 0x4646464646464646) | (v - 0x3030303030303030)) & 0x8080808080808080) != 0)
+			return false;
+		v -= 0x3030303030303030;
+		v = v*10 + (v >> 8); // Pairs of digits, in every other byte
+		value = static_cast<STD::uint32_t>((((v & 0x000000FF000000FF) * (100 + (1000000ull << 32)))
+		                                  + (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32)))) >> 32);
+		first += 8;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**< Appends up to max_digits decimal digits at first to value, advancing first past them. Returns their number. */
+	template <typename InputIt>
+	constexpr int parseDecimalDigits( InputIt& first, InputIt last, STD::uint64_t& value, int max_digits ) {
+		int count = 0;
+		STD::uint64_t eight = 0;
+		while (count + 8 <= max_digits && loadEightDigits(first, last, eight)) {
+			value = value*100000000 + eight;
+			count += 8;
+		}
+		for (unsigned d = 0; count < max_digits && first != last && (d = digitValue(*first)) < 10; ++first, ++count)
+			value = value*10 + d;
+		return count;
+	}
 }
 
 /** \brief Extracts an integer value from the character range specified by [first, last).
@@ -70,8 +145,6 @@ constexpr auto strToInt( InputIt first, InputIt last, Int& res, int base=10 )
 	constexpr auto MAX = STD::numeric_limits<Int>::max(),
 	               MIN = STD::numeric_limits<Int>::lowest();
 
-	String digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 	res = 0; // So premature error returns set res to zero
 
 	first = detail::skipWS(first, last);
@@ -98,11 +171,26 @@ constexpr auto strToInt( InputIt first, InputIt last, Int& res, int base=10 )
 		}
 	}
 
+	// Decimal values that fit in 64 bits are accumulated without any overflow checks, mostly eight digits at a time.
+	// Failures are left to the general loop below, which determines where the value went out of range.
+	if (base == 10 && sizeof(Int) <= sizeof(STD::uint64_t)) {
+		auto const digits_begin = first;
+		STD::uint64_t magnitude = 0;
+		auto const count = detail::parseDecimalDigits(first, last, magnitude, 19);
+		STD::uint64_t const limit = sign == 1? STD::uint64_t(MAX)
+		                          : MIN == 0? 0 : STD::uint64_t(-(MIN+1)) + 1;
+		if (count != 0 && (first == last || detail::digitValue(*first) >= 10) && magnitude <= limit) {
+			res = sign == 1 || magnitude == 0? Int(magnitude) : Int(-Int(magnitude-1) - 1);
+			return {first, PState::Good};
+		}
+		first = digits_begin;
+	}
+
 	res = 0;
 	bool read = false;
-	STD::size_t found=0;
+	unsigned found = 0;
 	while (first != last
-	   && (found = digits.rfind(toupper(*first), base-1)) != digits.npos)
+	   && (found = detail::digitValue(*first)) < unsigned(base))
 	{
 		const auto summand = sign*Int(found);
 
@@ -158,12 +246,140 @@ constexpr auto strToInt( BasicString<char, N> const& str, STD::size_t str_pos =
 	return strToInt<Int>(str.data()+str_pos, str.size(), pos, base);
 }
 
+namespace detail {
+
+	/**< Parses the significand and exponent of a floating-point value in the given base (10 or 16) by accumulating the
+	     digits in Float, which is not necessarily exact. read indicates whether a leading zero was consumed already. */
+	template <typename Float, typename InputIt>
+	constexpr PState parseFloatDigits( InputIt& first, InputIt last, Float& res, Float sign, int base, bool read ) {
+		Float multiplier = 1;
+		for (; first != last; ++first)
+		{
+			unsigned found = digitValue(*first);
+			if (found >= unsigned(base)) {
+				if (*first != '.' || multiplier != 1)
+					break;
+				multiplier /= base;
+				continue;
+			}
+
+			const auto summand = sign*multiplier*Float(found);
+
+			constexpr auto bound = STD::numeric_limits<Float>::max();
+			if (abs(res) > bound/base || abs(res)*base > bound-abs(summand)) {
+				res = bound;
+				return PState::Fail;
+			}
+
+			(res *= (multiplier == 1? base : 1)) += summand;
+
+			read = true;
+
+			if (multiplier != 1)
+				multiplier /= base;
+		}
+
+		if (!read) {res = 0; return PState::Eof;}
+
+		// Apply exponent
+		const char exp_char = base==10? 'E' : 'P';
+		if (first != last && toupper(*first) == exp_char) {
+			++first;
+			int exp=0;
+			auto p_state = strToInt(first, last, exp, 10); // exponent is always decimal
+			first = p_state.iterator;
+			if (p_state.state != PState::Good) {
+				res = 0;
+				return p_state.state;
+			}
+			auto factor = pow(Float(base==10? 10 : 2), exp);
+			res = safeMul(res, factor);
+		}
+
+		return PState::Good;
+	}
+
+	/**< Parses the significand and exponent of a decimal floating-point value and rounds it correctly. Up to 19
+	     significant digits are accumulated in an integer; the conversion is done by decimalToBinary. */
+	template <typename Float, typename InputIt>
+	constexpr auto parseDecimalFloat( InputIt& first, InputIt last, Float& res, Float sign, bool read )
+		-> require<isDecimalFormattable<Float>, PState>
+	{
+		constexpr int max_digits = 19;
+		STD::uint64_t w = 0;
+		STD::int64_t exponent = 0; // Of w
+		bool truncated = false;    // Whether a nonzero digit was not accumulated in w
+
+		for (; first != last && *first == '0'; ++first)
+			read = true;
+		auto significant = first;
+		int count = parseDecimalDigits(first, last, w, max_digits); // Of significant digits
+		for (unsigned d = 0; first != last && (d = digitValue(*first)) < 10; ++first, ++count, ++exponent)
+			truncated |= d != 0;
+
+		if (first != last && *first == '.') {
+			++first;
+			if (count == 0) {
+				for (; first != last && *first == '0'; ++first, --exponent)
+					read = true;
+				significant = first;
+			}
+			auto const fraction = parseDecimalDigits(first, last, w, count < max_digits? max_digits - count : 0);
+			count += fraction;
+			exponent -= fraction;
+			for (unsigned d = 0; first != last && (d = digitValue(*first)) < 10; ++first, ++count)
+				truncated |= d != 0;
+		}
+
+		if (!read && count == 0) return PState::Eof;
+
+		// As with strtod, the exponent is only consumed if it has digits
+		if (first != last && toupper(*first) == 'E') {
+			auto exponent_start = first++;
+			bool const negative = first != last && *first == '-';
+			if (first != last && (*first == '-' || *first == '+'))
+				++first;
+			if (first == last || digitValue(*first) >= 10)
+				first = exponent_start;
+			else {
+				STD::int64_t e = 0;
+				for (unsigned d = 0; first != last && (d = digitValue(*first)) < 10; ++first)
+					if (e < 100000) // Far beyond any finite nonzero result
+						e = e*10 + d;
+				exponent += negative? -e : e;
+			}
+		}
+
+		res = composeFloat<Float>(decimalToBinary<Float>(w, exponent, truncated, significant, count), sign < 0);
+		return PState::Good;
+	}
+
+	template <typename Float, typename InputIt>
+	constexpr auto parseDecimalFloat( InputIt& first, InputIt last, Float& res, Float sign, bool read )
+		-> require_not<isDecimalFormattable<Float>, PState>
+	{
+		return parseFloatDigits(first, last, res, sign, 10, read);
+	}
+}
+
+/** \brief Extracts a floating-point value from the character range specified by [first, last),
+ *         similar to STD::strtod: after optional whitespace and sign, either a decimal or (prefixed by 0x)
+ *         hexadecimal significand with an optional exponent, or infinity or NaN, are accepted.
+ *
+ *         Decimal values of IEEE single and double precision types are rounded correctly: the first 19
+ *         significant digits are converted with the Eisel-Lemire algorithm, and remaining ones are taken
+ *         into account by an exact comparison in the rare cases where they matter.
+ *
+ *         Decimal values too large in magnitude for Float yield infinity of the respective sign. If no value
+ *         could be extracted, the state is PState::Eof.
+ *
+ * \return A pair that contains both the iterator to the first non-consumed character
+ *         and the state that the parser had at the end of the operation.
+ */
 template <typename Float, typename InputIt>
 constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 	-> require<STD::is_floating_point<Float>, ParserState<InputIt>>
 {
-	String digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 	res = 0; // So a premature return (see below) does not leave res unset
 
 	first = detail::skipWS(first, last);
@@ -233,7 +449,9 @@ constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 
 		if (first != last && *first == '(') {
 			//! TODO: Implement proper NaN-String recognition
-			first = Constainer::find_first_not_of(first+1, last, digits.begin(), digits.end());
+			++first;
+			while (first != last && detail::digitValue(*first) < 36)
+				++first;
 			if (first == last || *first !=  ')')
 				return {first, PState::Eof};
 		}
@@ -243,51 +461,9 @@ constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 	}
 	}
 
-	Float multiplier = 1;
-	for (; first != last; ++first)
-	{
-		STD::size_t found = digits.rfind(toupper(*first), base-1);
-		if (found == digits.npos) {
-			if (*first != '.' || multiplier != 1)
-				break;
-			multiplier /= base;
-			continue;
-		}
-
-		const auto summand = sign*multiplier*Float(found);
-
-		constexpr auto bound = STD::numeric_limits<Float>::max();
-		if (abs(res) > bound/base || abs(res)*base > bound-abs(summand)) {
-			res = bound;
-			return {first, PState::Fail};
-		}
-
-		(res *= (multiplier == 1? base : 1)) += summand;
-
-		read = true;
-
-		if (multiplier != 1)
-			multiplier /= base;
-	}
-
-	if (!read) {res = 0; return {first, PState::Eof};}
-
-	// Apply exponent
-	const char exp_char = base==10? 'E' : 'P';
-	if (first != last && toupper(*first) == exp_char) {
-		++first;
-		int exp=0;
-		auto p_state = strToInt(first, last, exp, 10); // exponent is always decimal
-		first = p_state.iterator;
-		if (p_state.state != PState::Good) {
-			res = 0;
-			return {first, p_state.state};
-		}
-		auto factor = pow(Float(2), exp);
-		res = safeMul(res, factor);
-	}
-
-	return {first, PState::Good};
+	auto state = base == 10? detail::parseDecimalFloat(first, last, res, sign, read)
+	                       : detail::parseFloatDigits(first, last, res, sign, base, read);
+	return {first, state};
 }
 
 template <typename Float>
@@ -311,4 +487,65 @@ constexpr auto strToFloat( char const* str, STD::size_t* pos = 0 )
 	return strToFloat<Float>(str, CharTraits<char>::length(str), pos);
 }
 
+namespace detail {
+	template <typename T, typename InputIt>
+	constexpr auto parseField( InputIt first, InputIt last, T& res )
+		-> require<STD::is_integral<T>, ParserState<InputIt>> {
+		return strToInt(first, last, res);
+	}
+	template <typename T, typename InputIt>
+	constexpr auto parseField( InputIt first, InputIt last, T& res )
+		-> require<STD::is_floating_point<T>, ParserState<InputIt>> {
+		return strToFloat(first, last, res);
+	}
+}
+
+/** \brief Parses the fields of the character range [first, last), which are separated by delim, as
+ *         decimal values of type T and appends them to out. No intermediate strings are built:
+ *         the fields are parsed in place by strToInt or strToFloat, respectively.
+ *
+ *         Each field may be surrounded by whitespace. Parsing stops at the first field that
+ *         could not be parsed, with the state returned for it, or that is followed by anything
+ *         but whitespace and a delimiter, with the state PState::Eof. The values parsed up to
+ *         that point remain in out. If out cannot take another value, length_error is thrown.
+ *
+ * \param delim The delimiter, which may also be a whitespace character such as '\n'.
+ * \return A pair that contains both the iterator to the first non-consumed character
+ *         and the state that the parser had at the end of the operation.
+ */
+template <typename T, STD::size_t N, typename Traits, typename InputIt, typename CharT>
+constexpr ParserState<InputIt> parseDelimited( InputIt first, InputIt last, BasicVector<T, N, Traits>& out,
+                                               CharT delim ) {
+	for (;;) {
+		T value {};
+		auto st = detail::parseField(first, last, value);
+		first = st.iterator;
+		if (st.state != PState::Good)
+			return st;
+		out.push_back(value);
+
+		while (first != last && *first != delim && detail::isSpace(*first))
+			++first;
+		if (first == last)
+			return {first, PState::Good};
+		if (*first != delim)
+			return {first, PState::Eof};
+		++first;
+	}
+}
+
+template <typename T, STD::size_t N=defaultContainerSize>
+constexpr Vector<T, N> parseDelimited( char const* str, STD::size_t len, char delim = ',', STD::size_t* pos = 0 ) {
+	Vector<T, N> ret;
+
+	auto st = parseDelimited(str, str+len, ret, delim);
+	AssertExcept<STD::invalid_argument>(st.state != PState::Eof,  "Could not extract all fields");
+	AssertExcept<STD::out_of_range>    (st.state != PState::Fail, "Value represented is out of bounds");
+
+	if (pos)
+		*pos = st.iterator - str;
+
+	return ret;
+}
+
 }
@@ -5,13 +5,18 @@
 #pragma once
 
 #include "impl/Fundamental.hxx"
+#include "Algorithms.hxx"
 #include "Vector.hxx"
 #include "ChunkPool.hxx"
 #include "Operators.hxx"
+#include "impl/NodeIndex.hxx"
 
 namespace Constainer {
 
-template <typename T, typename Pool>
+/**< Index decides how positions are mapped to the nodes, see impl/NodeIndex.hxx. The default stores
+     a flat array of node pointers, giving O(1) access but O(N) back-pointer updates per insertion or
+     erasure. SegmentedNodeIndex trades O(log N) access for O(sqrt(N)) updates. */
+template <typename T, typename Pool, template <typename, STD::size_t> class Index = detail::FlatNodeIndex>
 class BasicStableVector
 {
 	struct Node;
@@ -33,8 +38,8 @@ public:
 private:
 	template <bool _const>
 	class _iterator_base;
-	using _pointer_container = Vector<Node*, max_size()+1>;
-	using _pointer_iter = Node**;
+	using _index_type = Index<Node, Pool::max_size()>;
+	using _slot_iterator = typename _index_type::slot_iterator;
 
 public:
 
@@ -47,29 +52,26 @@ public:
 private:
 	struct Node {
 		T value = {};
-		using _pointer_iter = Node**;
-		_pointer_iter up = nullptr;
+		typename _index_type::Link link {};
 
-		constexpr Node(const_reference value, _pointer_iter up)
-			: value(value), up(up) {}
 		constexpr Node() = default;
 
 		constexpr Node& operator=(Node const&) = default;
-		constexpr Node& operator=(Node && n) {value = STD::move(n.value); up = n.up; return *this;}
+		constexpr Node& operator=(Node && n) {value = STD::move(n.value); link = n.link; return *this;}
 		constexpr Node(Node const&) = default;
 		constexpr Node(Node &&) = default;
 
-		constexpr void setParent(_pointer_iter it) {
-			up = it;
-			*up = this;
+		constexpr void setParent(_slot_iterator it) {
+			*it = this;
+			_index_type::link(it);
 		}
 		template <typename... Args>
-		constexpr void setParent(_pointer_iter it, Args&&... args) {
+		constexpr void setParent(_slot_iterator it, Args&&... args) {
 			value = value_type(STD::forward<Args>(args)...); setParent(it);
 		}
 		// Avoid superfluous temporary if possible:
 		template <typename Arg>
-		constexpr auto setParent(_pointer_iter it, Arg&& arg)
+		constexpr auto setParent(_slot_iterator it, Arg&& arg)
 			-> require<STD::is_same<STD::decay_t<Arg>, value_type>> {
 			value = STD::forward<Arg>(arg); setParent(it);
 		}
@@ -104,31 +106,47 @@ private:
 		constexpr _iterator_base(_iterator_base<_const2> i) : _node(i._node) {}
 
 		constexpr _iterator_base(_iterator_base const& i) : _node(i._node) {}
+		constexpr _iterator_base& operator=(_iterator_base const&) = default;
 
 		constexpr _iterator_base() : _iterator_base(nullptr) {}
 
 		constexpr reference operator*() const {return _node->value;}
 
-		constexpr _iterator_base& operator+=(difference_type d) {return *this = _iterator_base(_node->up[ d]);}
-		constexpr _iterator_base& operator-=(difference_type d) {return *this = _iterator_base(_node->up[-d]);}
+		constexpr _iterator_base& operator+=(difference_type d) {return *this = _iterator_base(_index_type::advance(_node,  d));}
+		constexpr _iterator_base& operator-=(difference_type d) {return *this = _iterator_base(_index_type::advance(_node, -d));}
 
 		constexpr _iterator_base& operator++() {return *this += 1;}
 		constexpr _iterator_base& operator--() {return *this -= 1;}
 
 		constexpr difference_type operator-(_iterator_base rhs) const {
-			return _node->up - rhs._node->up;
+			return _index_type::distance(rhs._node, _node);
 		}
 
 		constexpr bool operator==(_iterator_base rhs) const {return _node == rhs._node;}
-		constexpr bool operator <(_iterator_base rhs) const {return _node->up < rhs._node->up;}
+		constexpr bool operator <(_iterator_base rhs) const {return _index_type::distance(_node, rhs._node) > 0;}
 	};
 
-	constexpr _pointer_iter _piter_of(const_iterator it) {return it._node->up;}
+	static constexpr _slot_iterator _piter_of(const_iterator it) {return _index_type::slot_of(it._node);}
+
+	template <typename Compare>
+	struct _node_compare {
+		Compare comp;
+		constexpr bool operator()(Node const* lhs, Node const* rhs) const {return comp(lhs->value, rhs->value);}
+	};
+
+	/**< Merges by relinking the nodes, such that iterators stay attached to their elements. */
+	template <typename Compare>
+	friend constexpr void inplaceMerge( BasicStableVector& v, iterator first, iterator middle, iterator last, Compare comp ) {
+		auto pfirst = v._piter_of(first), plast = v._piter_of(last);
+		Constainer::inplace_merge(pfirst, v._piter_of(middle), plast, _node_compare<Compare>{comp});
+		for (; pfirst != plast; ++pfirst)
+			_index_type::link(pfirst);
+	}
 
 public:
 
-	constexpr const_iterator  begin() const {return iterator(_pointers.front());}
-	constexpr const_iterator    end() const {return iterator(_pointers.back());}
+	constexpr const_iterator  begin() const {return iterator(_index.at(0));}
+	constexpr const_iterator    end() const {return iterator(const_cast<Node*>(&_endNode));}
 	constexpr       iterator  begin()       {return as_const(*this).begin();}
 	constexpr       iterator    end()       {return as_const(*this).end();}
 	constexpr const_iterator cbegin() const {return begin();}
@@ -144,8 +162,8 @@ public:
 private:
 
 	pool_type _pool {};
-	_pointer_container _pointers {&_endNode};
-	Node _endNode{{}, _pointers.begin()};
+	Node _endNode {};
+	_index_type _index {&_endNode};
 
 	constexpr void _append(BasicStableVector const& s) {
 		insert(end(), s.begin(), s.end());
@@ -158,18 +176,21 @@ private:
 
 public:
 
-	constexpr void clear() {_pool.free(); _pointers.clear();}
+	constexpr void clear() {
+		_pool.free();
+		_index.clear();
+	}
 
-	constexpr size_type size() const {return _pointers.size()-1;}
+	constexpr size_type size() const {return _index.size();}
 	constexpr bool     empty() const {return size() == 0;}
 
-	constexpr       reference front()       {return _pointers.front()->value;}
-	constexpr       reference  back()       {return _pointers. back()->value;}
-	constexpr const_reference front() const {return _pointers.front()->value;}
-	constexpr const_reference  back() const {return _pointers. back()->value;}
+	constexpr       reference front()       {return _index.at(0)->value;}
+	constexpr       reference  back()       {return _index.at(size()-1)->value;}
+	constexpr const_reference front() const {return _index.at(0)->value;}
+	constexpr const_reference  back() const {return _index.at(size()-1)->value;}
 
-	constexpr       reference operator[](size_type s)       {return _pointers[s]->value;}
-	constexpr const_reference operator[](size_type s) const {return _pointers[s]->value;}
+	constexpr       reference operator[](size_type s)       {return _index.at(s)->value;}
+	constexpr const_reference operator[](size_type s) const {return _index.at(s)->value;}
 
 	constexpr BasicStableVector() = default;
 	constexpr explicit BasicStableVector(size_type s)  {
@@ -191,67 +212,63 @@ public:
 
 	constexpr BasicStableVector& operator=(BasicStableVector const& s) {
 		clear(); _append(s);
+		return *this;
 	}
 	constexpr BasicStableVector& operator=(BasicStableVector && s) {
 		clear(); _append(STD::move(s));
+		return *this;
 	}
 
 private:
 	template <typename... Args>
-	constexpr void _initialize( _pointer_iter it, Args&&... args) {
+	constexpr void _initialize( _slot_iterator it, Args&&... args) {
 		_pool.grab()->setParent(it, STD::forward<Args>(args)...);
 	}
 
-	// Shifts all elements in [it, _pointers.end()) by n elements to the right, so
-	// n empty are made available. The
-	constexpr void _shift(_pointer_iter it, size_type n) {
-		auto start = _pointers.end();
-		_pointers.resize(_pointers.size() + n);
-		while (start != it) {
-			--start;
-			(*start)->setParent(start+n);
-		}
-	}
+	constexpr iterator _unconst(const_iterator it) {return iterator(it._node);}
 
 	template <typename InputIt>
-	constexpr void _insert_n(const_iterator it, size_type d, InputIt first) {
-		auto pointer_iter = it._node->up;
-		_shift(pointer_iter, d);
-		while (d--)
-			_initialize(pointer_iter++, *first++);
+	constexpr iterator _insert_n(const_iterator it, size_type d, InputIt first) {
+		if (d == 0)
+			return _unconst(it);
+		auto slot = _index.open(_piter_of(it), d), first_slot = slot;
+		_pool.grab_n(d, slot);
+		for (; d--; ++slot)
+			(*slot)->setParent(slot, *first++);
+		return iterator(*first_slot);
 	}
 
 	template <typename ForwardIt>
-	constexpr void _insert(const_iterator it, ForwardIt first, ForwardIt last, STD::forward_iterator_tag) {
-		_insert_n(it, Constainer::distance(first, last), first);
+	constexpr iterator _insert(const_iterator it, ForwardIt first, ForwardIt last, STD::forward_iterator_tag) {
+		return _insert_n(it, Constainer::distance(first, last), first);
 	}
 
-	template <typename ForwardIt>
-	constexpr void _insert(const_iterator it, ForwardIt first, ForwardIt last, STD::input_iterator_tag) {
-		auto pointer_iter = it._node->up;
-		while (first != last) {
-			_shift(it, 1);
-			_initialize(pointer_iter++, *first++);
-		}
+	template <typename InputIt>
+	constexpr iterator _insert(const_iterator it, InputIt first, InputIt last, STD::input_iterator_tag) {
+		auto pos = it - cbegin();
+		for (; first != last; ++it)
+			it = emplace(it, *first++);
+		return begin() + pos;
 	}
 
 	template <typename... Args>
 	constexpr iterator _insert_repeat(const_iterator it, size_type n, Args const&... args) {
-		auto pointer_iter = _piter_of(it);
-		_shift(pointer_iter, n);
-		while (n--)
-			_initialize(pointer_iter++, args...);
-		return it;
+		if (n == 0)
+			return _unconst(it);
+		auto slot = _index.open(_piter_of(it), n), first_slot = slot;
+		_pool.grab_n(n, slot);
+		for (; n--; ++slot)
+			(*slot)->setParent(slot, args...);
+		return iterator(*first_slot);
 	}
 
 public:
 
 	template <typename... Args>
 	constexpr iterator emplace(const_iterator it, Args&&... args) {
-		auto pointer_iter = _piter_of(it);
-		_shift(pointer_iter, 1);
-		_initialize(pointer_iter, STD::forward<Args>(args)...);
-		return it;
+		auto slot = _index.open(_piter_of(it), 1);
+		_initialize(slot, STD::forward<Args>(args)...);
+		return iterator(*slot);
 	}
 
 	constexpr iterator insert(const_iterator it, const_reference v) {return emplace(it, v);}
@@ -263,20 +280,17 @@ public:
 	template <typename InputIterator>
 	constexpr require<isInputIterator<InputIterator>, iterator>
 	insert(const_iterator it, InputIterator first, InputIterator last) {
-		_insert(it, first, last, typename STD::iterator_traits<InputIterator>::iterator_category{});
-		return it;
+		return _insert(it, first, last, typename STD::iterator_traits<InputIterator>::iterator_category{});
 	}
 	/**< Inserts [first, first+d). Useful if InputIterator is an input iterator only. */
 	template <typename InputIterator>
 	constexpr require<isInputIterator<InputIterator>, iterator>
 	insert(const_iterator it, size_type d, InputIterator first) {
-		_insert_n(it, d, first);
-		return it;
+		return _insert_n(it, d, first);
 	}
 
 	constexpr iterator insert(const_iterator it, STD::initializer_list<value_type> ilist) {
-		_insert(it, ilist.begin(), ilist.end(), STD::random_access_iterator_tag{});
-		return it;
+		return _insert(it, ilist.begin(), ilist.end(), STD::random_access_iterator_tag{});
 	}
 
 	constexpr void push_back( const_reference x ) {insert(end(), x);}
@@ -290,19 +304,12 @@ public:
 	constexpr iterator erase(const_iterator first, const_iterator last) {
 		auto pfirst=_piter_of(first), plast=_piter_of(last);
 		for (auto i = pfirst; i != plast; ++i)
-			_pool.free(*i++);
-		_pointers.erase(pfirst, plast);
-		for (; pfirst != _pointers.end(); ++pfirst)
-			(*pfirst)->up = pfirst;
-		return first;
+			_pool.free(*i);
+		_index.close(pfirst, plast);
+		return _unconst(last);
 	}
 	constexpr iterator erase(const_iterator i) {
-		auto pi = _piter_of(i);
-		_pool.free(*pi);
-		_pointers.erase(pi);
-		while (pi != _pointers.end())
-			--(*pi++)->up;
-		return i;
+		return erase(i, Constainer::next(i));
 	}
 
 	constexpr void resize(size_type s) {
@@ -317,28 +324,38 @@ public:
 template <typename T, STD::size_t MaxN=defaultContainerSize>
 using StableVector = BasicStableVector<T, ChunkPool<T, MaxN>>;
 
-template <typename... A1, typename... A2>
-constexpr bool operator==(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+/**< Prefer this for large vectors that see insertions and erasures away from the end. */
+template <typename T, STD::size_t MaxN=defaultContainerSize>
+using SegmentedStableVector = BasicStableVector<T, ChunkPool<T, MaxN>, detail::SegmentedNodeIndex>;
+
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator==(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return lhs.size() == rhs.size() && Constainer::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
-template <typename... A1, typename... A2>
-constexpr bool operator <(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator <(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return Constainer::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
-template <typename... A1, typename... A2>
-constexpr bool operator!=(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator!=(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return !(lhs == rhs);
 }
-template <typename... A1, typename... A2>
-constexpr bool operator>=(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator>=(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return !(lhs < rhs);
 }
-template <typename... A1, typename... A2>
-constexpr bool operator >(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator >(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return rhs < lhs;
 }
-template <typename... A1, typename... A2>
-constexpr bool operator<=(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
+template <typename T1, typename P1, template <typename, STD::size_t> class I1,
+          typename T2, typename P2, template <typename, STD::size_t> class I2>
+constexpr bool operator<=(BasicStableVector<T1, P1, I1> const& lhs, BasicStableVector<T2, P2, I2> const& rhs) {
 	return !(lhs > rhs);
 }
 
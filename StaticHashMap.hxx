@@ -0,0 +1,244 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Bitset.hxx"
+#include "FlatMap.hxx"
+#include "FlatSet.hxx"
+#include "String.hxx"
+
+#include <initializer_list>
+
+namespace Constainer {
+
+/**< Default hasher of the static hash containers. Strings are hashed with hash(), such that
+     a char const* can be looked up in a container of BasicStrings. */
+struct HashFunctor {
+	template <STD::size_t N, typename Traits>
+	constexpr STD::size_t operator()(BasicString<char, N, Traits> const& str) const {return hash(str);}
+	constexpr STD::size_t operator()(char const* str) const {return hash(str);}
+
+	template <typename T, typename=STD::enable_if_t<STD::is_integral<T>{} or STD::is_enum<T>{}>>
+	constexpr STD::size_t operator()(T t) const {return static_cast<STD::size_t>(t);}
+};
+
+namespace detail {
+	/**< Derives the hash for a given displacement seed from the hash of the key, using the
+	     finaliser of MurmurHash3. The key itself is therefore only hashed once per lookup,
+	     and the reduction modulo the table size depends on all bits of h. */
+	CONSTAINER_PURE_CONST constexpr STD::uint64_t reseedHash(STD::uint64_t h, STD::uint64_t seed) {
+		h ^= seed * 0x9e3779b97f4a7c15;
+		h = (h ^ (h >> 33)) * 0xff51afd7ed558ccd;
+		h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53;
+		return h ^ (h >> 33);
+	}
+
+	template <typename SizeType, STD::size_t N>
+	struct BucketOrder {
+		Array<SizeType, N> const* bucket_of;
+		Array<SizeType, N> const* bucket_size;
+		/**< Larger buckets first, elements of one bucket adjacent. */
+		constexpr bool operator()(SizeType lhs, SizeType rhs) const {
+			auto bl = (*bucket_of)[lhs], br = (*bucket_of)[rhs];
+			return (*bucket_size)[bl] > (*bucket_size)[br]
+			    || ((*bucket_size)[bl] == (*bucket_size)[br] && bl < br);
+		}
+	};
+
+/**< A hash table over a key set that is fixed at construction. The construction computes a minimal
+     perfect hash function following the "hash, displace and compress" scheme: the keys are distributed
+     onto size() buckets, and each bucket gets a displacement seed under which its keys land in distinct,
+     free slots. Buckets holding a single key directly store the index of their slot instead.
+     A lookup is thus one hash of the key, one slot probe and one key comparison. */
+template <typename Key, typename Value, typename KeyOfValue, STD::size_t N, typename Hash, typename KeyEqual>
+class StaticHashTable {
+	using _storage_type = Array<Value, N>;
+
+public:
+	using key_type = Key;
+	using value_type = Value;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+	using size_type       = typename _storage_type::size_type;
+	using difference_type = typename _storage_type::difference_type;
+	using reference       = STD::conditional_t<STD::is_same<Key, Value>{}, typename _storage_type::const_reference,
+	                                                                       typename _storage_type::reference>;
+	using const_reference = typename _storage_type::const_reference;
+	using pointer         = STD::conditional_t<STD::is_same<Key, Value>{}, typename _storage_type::const_pointer,
+	                                                                       typename _storage_type::pointer>;
+	using const_pointer   = typename _storage_type::const_pointer;
+	using iterator        = pointer;
+	using const_iterator  = const_pointer;
+
+private:
+	_storage_type _values {};
+	/**< Indexed by bucket. Non-negative entries are seeds for reseedHash, negative entries encode
+	     the slot -d-1 of a bucket's single key. */
+	Array<STD::ptrdiff_t, N> _displacements {};
+	size_type _size = 0;
+	hasher _hash;
+	key_equal _key_eq;
+
+	/**< Bounds the search for a bucket's seed, which only takes long if the hashes of the keys are degenerate. */
+	static constexpr STD::ptrdiff_t _max_seed = 1 << 16;
+
+	template <typename K>
+	constexpr size_type _slot(K const& key) const {
+		STD::uint64_t h = _hash(key);
+		auto d = _displacements[reseedHash(h, 0) % _size];
+		return d < 0? -d-1 : reseedHash(h, d) % _size;
+	}
+
+	constexpr void _build() {
+		auto const n = _size;
+		Array<STD::uint64_t, N> hashes {};
+		Array<size_type, N> bucket_of {}, bucket_size {}, order {}, slot_of {};
+		for (size_type i = 0; i != n; ++i) {
+			hashes[i] = _hash(KeyOfValue()(_values[i]));
+			bucket_of[i] = reseedHash(hashes[i], 0) % n;
+			++bucket_size[bucket_of[i]];
+			order[i] = i;
+		}
+		Constainer::sort(order.begin(), order.begin()+n, BucketOrder<size_type, N>{&bucket_of, &bucket_size});
+
+		Bitset<N> taken;
+		size_type i = 0;
+		for (size_type len = 0; i != n && (len = bucket_size[bucket_of[order[i]]]) > 1; i += len) {
+			// Keys with equal hashes necessarily share a bucket, and would never be separated by any seed
+			for (size_type j = i; j != i+len; ++j)
+				for (size_type k = j+1; k != i+len; ++k) {
+					AssertExcept<STD::invalid_argument>(!_key_eq(KeyOfValue()(_values[order[j]]), KeyOfValue()(_values[order[k]])),
+					                                    "Duplicate key in StaticHashTable");
+					AssertExcept<STD::invalid_argument>(hashes[order[j]] != hashes[order[k]],
+					                                    "Keys with equal hashes in StaticHashTable");
+				}
+			for (STD::ptrdiff_t seed = 1;; ++seed) {
+				AssertExcept<STD::invalid_argument>(seed <= _max_seed, "No displacement found for a bucket of StaticHashTable");
+				size_type j = i;
+				for (; j != i+len; ++j) {
+					auto s = reseedHash(hashes[order[j]], seed) % n;
+					if (taken.test(s))
+						break;
+					taken.set(s);
+					slot_of[order[j]] = s;
+				}
+				if (j == i+len) {
+					_displacements[bucket_of[order[i]]] = seed;
+					break;
+				}
+				while (j-- != i)
+					taken.reset(slot_of[order[j]]);
+			}
+		}
+		for (size_type free = 0; i != n; ++i) {
+			while (taken.test(free))
+				++free;
+			taken.set(free);
+			slot_of[order[i]] = free;
+			_displacements[bucket_of[order[i]]] = -STD::ptrdiff_t(free) - 1;
+		}
+
+		auto values = _values;
+		for (size_type j = 0; j != n; ++j)
+			_values[slot_of[j]] = STD::move(values[j]);
+	}
+
+public:
+	constexpr StaticHashTable() : _hash{}, _key_eq{} {}
+
+	template <typename InputIt>
+	constexpr StaticHashTable(InputIt first, InputIt last, hasher const& hash = {}, key_equal const& eq = {})
+		: _hash(hash), _key_eq(eq) {
+		for (; first != last; ++first) {
+			AssertExcept<STD::bad_alloc>(_size != max_size());
+			_values[_size++] = *first;
+		}
+		_build();
+	}
+	constexpr StaticHashTable(STD::initializer_list<value_type> ilist, hasher const& hash = {}, key_equal const& eq = {})
+		: StaticHashTable(ilist.begin(), ilist.end(), hash, eq) {}
+
+	constexpr hasher      hash_function() const {return _hash;}
+	constexpr key_equal          key_eq() const {return _key_eq;}
+
+	constexpr         bool empty() const {return _size == 0;}
+	constexpr size_type     size() const {return _size;}
+	static constexpr size_type max_size() {return N;}
+
+	constexpr       iterator  begin()       {return _values.begin();}
+	constexpr       iterator    end()       {return _values.begin() + _size;}
+	constexpr const_iterator  begin() const {return _values.begin();}
+	constexpr const_iterator    end() const {return _values.begin() + _size;}
+	constexpr const_iterator cbegin() const {return begin();}
+	constexpr const_iterator   cend() const {return end();}
+
+	/**< Accepts any type that hasher and key_equal accept, e.g. a char const* for string keys. */
+	template <typename K>
+	constexpr iterator find(K const& key) {
+		if (empty())
+			return end();
+		auto pos = begin() + _slot(key);
+		return _key_eq(KeyOfValue()(*pos), key)? pos : end();
+	}
+	template <typename K>
+	constexpr const_iterator find(K const& key) const {
+		return const_cast<StaticHashTable*>(this)->find(key);
+	}
+
+	template <typename K>
+	constexpr size_type count(K const& key) const {
+		return find(key) != end();
+	}
+};
+}
+
+template <typename Key, STD::size_t N=defaultContainerSize, typename Hash = HashFunctor, typename KeyEqual = STD::equal_to<>>
+class StaticHashSet : public detail::StaticHashTable<Key, Key, IdentityFunctor, N, Hash, KeyEqual> {
+	using _base = detail::StaticHashTable<Key, Key, IdentityFunctor, N, Hash, KeyEqual>;
+
+public:
+	using _base::_base;
+
+	template <typename C, typename Cont>
+	constexpr explicit StaticHashSet(BasicFlatSet<Key, C, Cont> const& set)
+		: _base(set.begin(), set.end()) {}
+};
+
+template <typename Key, typename Mapped, STD::size_t N=defaultContainerSize,
+          typename Hash = HashFunctor, typename KeyEqual = STD::equal_to<>>
+class StaticHashMap : public detail::StaticHashTable<Key, ConstKeyPair<Key, Mapped>,
+                                                     typename ConstKeyPair<Key, Mapped>::KeyOfPair, N, Hash, KeyEqual> {
+	using _base = detail::StaticHashTable<Key, ConstKeyPair<Key, Mapped>,
+	                                      typename ConstKeyPair<Key, Mapped>::KeyOfPair, N, Hash, KeyEqual>;
+
+public:
+	using _base::_base;
+
+	using mapped_type = Mapped;
+
+	using typename _base::reference;
+	using typename _base::const_reference;
+
+	/**< Converts constexpr tables that were written as FlatMaps. */
+	template <typename C, typename Cont>
+	constexpr explicit StaticHashMap(BasicFlatMap<Key, Mapped, C, Cont> const& map)
+		: _base(map.begin(), map.end()) {}
+
+	template <typename K>
+	constexpr       reference at(K const& key) {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->end(), "");
+		return *pos;
+	}
+	template <typename K>
+	constexpr const_reference at(K const& key) const {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->cend(), "");
+		return *pos;
+	}
+};
+
+}
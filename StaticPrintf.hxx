@@ -8,6 +8,7 @@
 #include "Stack.hxx"
 #include "Math.hxx"
 #include "RangeAccess.hxx"
+#include "impl/FloatDecimal.hxx"
 
 #include <type_traits>
 
@@ -24,7 +25,9 @@ constexpr require<STD::is_floating_point<T>> writeDigitsReversed ( StringType& s
 template <typename StringType, typename T, typename P>
 constexpr require<STD::is_integral<T>> writeDigitsReversed ( StringType& str, T t, int base, P digits ) {
 	do {
-		str += digits[t % base];
+		// Negative remainders for negative t; negating t instead could overflow
+		auto digit = t % base;
+		str += digits[digit < 0? -digit : digit];
 		t /= base;
 	}
 	while (t != 0);
@@ -380,6 +383,227 @@ struct Parser {
 		return str;
 	}
 
+	/**< The conversions below produce exactly rounded decimal output through writeRoundedDigits and shortestDecimal
+	     for IEEE single and double precision arguments. Rather than building a reversed string, they write the field
+	     into a local buffer, which is padded and appended at once. Other types take the general paths above.
+	     The layout functions take the n significant digits at first, which is followed by room characters, and
+	     return the length of the field, or its negation if it doesn't fit. */
+
+	/**< The number of the n digits at first that remain when trailing zeroes are removed, but at least keep. */
+	static constexpr int _trimZeroes ( CharT const* first, int n, int keep ) {
+		while (n > keep && first[n-1] == Tokens::zero)
+			--n;
+		return n;
+	}
+
+	/**< d.ddd followed by the exponent. */
+	static constexpr int _layoutScientific ( CharT* first, int room, int n, Info const& info, int exponent, bool trimTrailingZeroes ) {
+		if (trimTrailingZeroes)
+			n = _trimZeroes (first, n, 1);
+		bool point = n > 1 || info.alternative;
+		auto e = abs (exponent);
+		int size = n + point + (e >= 100? 5 : 4);
+		if (size > room)
+			return -size;
+
+		auto last = first + n;
+		if (point) {
+			for (auto i = n; --i > 0;)
+				first[i+1] = first[i];
+			first[1] = Tokens::decimalPoint;
+			++last;
+		}
+		auto digits = Tokens::get_digits (false);
+		*last++ = info.upper? Tokens::upperExp : Tokens::lowerExp;
+		*last++ = exponent < 0? Tokens::minus : Tokens::plus;
+		if (e >= 100)
+			*last++ = digits[e / 100];
+		*last++ = digits[e / 10 % 10];
+		*last = digits[e % 10];
+		return size;
+	}
+
+	/**< The digits with a decimal point in front of all but the first integral ones. */
+	static constexpr int _layoutFixed ( CharT* first, int room, int n, int integral, Info const& info ) {
+		bool point = n > integral || info.alternative;
+		if (n + point > room)
+			return -(n + point);
+		if (point) {
+			for (auto i = n; i-- > integral;)
+				first[i+1] = first[i];
+			first[integral] = Tokens::decimalPoint;
+		}
+		return n + point;
+	}
+
+	/**< As %g does with the given precision, i.e. in fixed notation if the exponent of the first digit is in
+	     [-4, precision), otherwise in scientific notation. */
+	static constexpr int _layoutGeneral ( CharT* first, int room, int n, Info const& info, int exponent, int precision, bool trimTrailingZeroes ) {
+		if (precision <= exponent || exponent < -4)
+			return _layoutScientific (first, room, n, info, exponent, trimTrailingZeroes);
+		if (exponent < 0) {
+			if (trimTrailingZeroes)
+				n = _trimZeroes (first, n, 1);
+			// 0.000ddd: The digits move behind the point and the zeroes following it
+			int shift = 1 - exponent;
+			if (n + shift > room)
+				return -(n + shift);
+			for (auto i = n; i-- > 0;)
+				first[i+shift] = first[i];
+			first[0] = Tokens::zero;
+			first[1] = Tokens::decimalPoint;
+			for (int i = 2; i != shift; ++i)
+				first[i] = Tokens::zero;
+			return n + shift;
+		}
+		int integral = exponent+1;
+		if (n < integral) {
+			if (integral > room)
+				return -(integral + info.alternative);
+			for (; n != integral; ++n)
+				first[n] = Tokens::zero;
+		}
+		else if (trimTrailingZeroes)
+			n = _trimZeroes (first, n, integral);
+		return _layoutFixed (first, room, n, integral, info);
+	}
+
+	/**< The shortest representation of the value of b that reads back as the same value, laid out like %g with the
+	     given precision. */
+	static constexpr int _writeShortest ( CharT* first, int room, Info const& info, BinaryFloat const& b, int precision ) {
+		CharT buffer[20] {Tokens::zero};
+		auto shortest = buffer;
+		int n = 1, exponent = 0;
+		if (b.mantissa != 0) {
+			auto d = shortestDecimal (b);
+			shortest = writeDecimalBackwards (buffer + 20, d.digits, Tokens::get_digits (false));
+			n = buffer + 20 - shortest;
+			exponent = d.exponent + n - 1;
+		}
+		if (n > room)
+			return -n;
+		for (int i = 0; i != n; ++i)
+			first[i] = shortest[i];
+		return _layoutGeneral (first, room, n, info, exponent, precision, true);
+	}
+
+	/**< Writes the field of arg for the decimal conversion given by its lower case token (%f, %e, %g or %@), including
+	     its sign but without padding, to out. Returns its length, or the negation of a capacity that is needed if
+	     capacity doesn't suffice, which is exact once the digits fit. Infinities and NaNs are written as
+	     handleAbnormality does. */
+	template <typename Arg>
+	static constexpr int writeDecimal ( CharT* out, int capacity, Info const& info, CharT conversion, Arg arg ) {
+		if (arg != arg || arg < STD::numeric_limits<Arg>::lowest() || arg > STD::numeric_limits<Arg>::max()) {
+			auto name = arg != arg? (info.upper? Tokens::upperNaN : Tokens::lowerNaN)
+			                      : (info.upper? Tokens::upperInf : Tokens::lowerInf);
+			bool sign = arg < 0 || info.prepend != '\0';
+			int size = sign + Traits::length (name);
+			if (size > capacity)
+				return -size;
+			if (sign)
+				*out++ = arg < 0? Tokens::minus : info.prepend;
+			for (; *name; ++name)
+				*out++ = *name;
+			return size;
+		}
+
+		auto b = decompose (arg);
+		bool sign = b.negative || info.prepend != '\0';
+		if (capacity < sign)
+			return -int(sign);
+		if (sign)
+			out[0] = b.negative? Tokens::minus : info.prepend;
+		auto first = out + sign;
+		auto room = capacity - sign;
+
+		auto digits = Tokens::get_digits (false);
+		int n = 0, exponent = 0;
+		if (conversion == Tokens::universal && info.precision < 0)
+			n = _writeShortest (first, room, info, b, STD::numeric_limits<Arg>::max_digits10);
+		else if (conversion == Tokens::lowerFixed) {
+			int precision = info.precision >= 0? info.precision : 6;
+			n = writeRoundedDigits (first, room, b, precision, true, digits, exponent);
+			if (n >= 0)
+				n = _layoutFixed (first, room, n, n - precision, info);
+		}
+		else if (conversion == Tokens::lowerExp) {
+			int precision = info.precision >= 0? info.precision : 6;
+			n = writeRoundedDigits (first, room, b, precision, false, digits, exponent);
+			if (n >= 0)
+				n = _layoutScientific (first, room, n, info, exponent, false);
+		}
+		else /* %g, or %@ with a precision */ {
+			int precision = info.precision < 0? 6 : info.precision == 0? 1 : info.precision;
+			n = writeRoundedDigits (first, room, b, precision-1, false, digits, exponent);
+			if (n >= 0)
+				n = _layoutGeneral (first, room, n, info, exponent, precision, not info.alternative);
+		}
+		return n < 0? n - sign : n + sign;
+	}
+
+	/**< Appends the field [first, first+length) to str, padded as pad_and_reverse pads a reversed one. */
+	template <typename StringType>
+	static constexpr void appendPadded ( StringType& str, Info const& info, CharT const* first, int length ) {
+		if (info.width <= length) {
+			str.append (first, length);
+			return;
+		}
+		int needed = info.width - length;
+		switch (info.alignment) {
+			case Info::left_justified:
+				str.append (first, length);
+				str.append (needed, info.pad);
+			break;
+			case Info::central:
+				str.append (needed/2, info.pad);
+				str.append (first, length);
+				str.append ((needed+1)/2, info.pad);
+			break;
+			case Info::internal:
+				if (*first == Tokens::space || *first == Tokens::plus || *first == Tokens::minus) {
+					str += *first++;
+					--length;
+				}
+			// fallthrough
+			default: // right-justified
+				str.append (needed, info.pad);
+				str.append (first, length);
+		}
+	}
+
+	/**< Appends the padded field of a %f, %e, %g or %@ conversion of arg to str. */
+	template <typename StringType, typename Arg>
+	static constexpr auto appendDecimal ( StringType& str, Info const& info, CharT conversion, Arg arg )
+	  -> require<isDecimalFormattable<Arg>>
+	{
+		// Enough for all but fixed notation of large values and high precisions
+		constexpr int buffer_size = 48;
+		CharT buffer[buffer_size] {};
+		auto length = writeDecimal (buffer, buffer_size, info, conversion, arg);
+		if (length >= 0)
+			appendPadded (str, info, buffer, length);
+		else {
+			// The field is written into a string instead, grown until it suffices. This fails only if the digits
+			// or the field exceed StringType's capacity, in which case str couldn't take them either.
+			StringType field;
+			do {
+				field.append (-length - field.size(), CharT());
+				length = writeDecimal (&field[0], int(field.size()), info, conversion, arg);
+			} while (length < 0);
+			appendPadded (str, info, field.data(), length);
+		}
+	}
+	template <typename StringType, typename Arg>
+	static constexpr auto appendDecimal ( StringType& str, Info const& info, CharT conversion, Arg arg )
+	  -> require_not<isDecimalFormattable<Arg>>
+	{
+		auto field = conversion == Tokens::lowerFixed? printFloat<StringType>(false, info, arg)
+		           : conversion == Tokens::lowerExp?   printExponential<StringType>(false, info, arg)
+		                                           :   printFloatHybrid<StringType>(info, arg);
+		pad_and_reverse (STD::true_type{}, field, info);
+		str += field;
+	}
+
 	template <typename StringType, typename Arg>
 	static constexpr StringType printInt (Info const& info, Arg arg)
 	{
@@ -488,7 +712,10 @@ struct Parser {
 		template <typename StringType, typename Arg>
 		constexpr void evaluate ( StringType& string, Arg arg ) {
 			// Hexfloat fractional trailing zeroes are trimmed (at least with libc++)
-			string += this->pad_and_reverse (STD::true_type {}, Parser::printExponential<StringType>(this->base==16, *this, arg) );
+			if (this->base == 16)
+				string += this->pad_and_reverse (STD::true_type {}, Parser::printExponential<StringType>(true, *this, arg));
+			else
+				appendDecimal (string, *this, Tokens::lowerExp, arg);
 		}
 	};
 	template <CharT... ch>
@@ -503,7 +730,7 @@ struct Parser {
 	struct handleFormatSpecifier<Tokens::lowerHybrid, ch...> : handleRest<ch...> {
 		template <typename StringType, typename Arg>
 		constexpr void evaluate ( StringType& str, Arg arg ) {
-			str += this->pad_and_reverse (STD::true_type {}, printFloatHybrid<StringType>(*this, arg) );
+			appendDecimal (str, *this, Tokens::lowerHybrid, arg);
 		}
 	};
 	template <CharT... ch>
@@ -518,7 +745,7 @@ struct Parser {
 	struct handleFormatSpecifier<Tokens::lowerFixed, ch...> : handleRest<ch...> {
 		template <typename StringType, typename Arg>
 		constexpr void evaluate ( StringType& string, Arg arg ) {
-			string += this->pad_and_reverse(STD::true_type{}, printFloat<StringType>(STD::false_type{}, *this, arg));
+			appendDecimal (string, *this, Tokens::lowerFixed, arg);
 		}
 	};
 	template <CharT... ch>
@@ -622,7 +849,7 @@ struct Parser {
 		constexpr auto call ( detail::rank<1>, StringType& str, Arg arg )
 		  -> require<STD::is_floating_point<Arg>>
 		{
-			str += this->pad_and_reverse (STD::true_type{}, printFloatHybrid<StringType>(*this, arg) );
+			appendDecimal (str, *this, Tokens::universal, arg);
 		}
 		template <typename StringType, typename Arg>
 		void call ( detail::rank<10>, StringType& str, Arg const& arg )
@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include "Array.hxx"
 #include "impl/BasicVector.hxx"
+#include "impl/StringKernels.hxx"
 
 #include <string> // char_traits
 
@@ -30,6 +32,10 @@ public:
 	static constexpr bool eq_int_type(int_type const& lhs, int_type const& rhs) { return lhs == rhs; }
 
 	static constexpr int compare(char_type const* s1, char_type const* s2, STD::size_t n) {
+		if (detail::scanBytewise<char_type>()) {
+			auto i = detail::firstMismatch(s1, s2, n);
+			return i == n? 0 : lt(s1[i], s2[i])? -1 : 1;
+		}
 		for (STD::size_t i = 0; i < n; ++i)
 			     if (lt(s1[i], s2[i]))
 				return -1;
@@ -40,6 +46,8 @@ public:
 	}
 
 	static constexpr STD::size_t length(char_type const* p) {
+		if (detail::scanBytewise<char_type>())
+			return detail::strLength(p);
 		STD::size_t i = 0;
 		while (!eq(*p++, char_type()))
 			++i;
@@ -48,6 +56,8 @@ public:
 	}
 
 	static constexpr char_type const* find(char_type const* s, STD::size_t n, char_type const& a) {
+		if (detail::scanBytewise<char_type>())
+			return detail::memFind(s, n, a);
 		for (; n--; ++s)
 			if (eq(*s, a))
 				return s;
@@ -55,11 +65,11 @@ public:
 	}
 
 	static constexpr char_type* copy(char_type* s1, char_type const* s2, STD::size_t n) {
-		return Constainer::copy_n(s2, n, s1);
+		return detail::copyElements(s1, s2, n, detail::CopyBitwise<char_type>{});
 	}
 
 	static constexpr char_type* move(char_type* s1, char_type const* s2, STD::size_t n) {
-		return Constainer::move_n(s2, n, s1);
+		return detail::moveElements(s1, s2, n, detail::CopyBitwise<char_type>{});
 	}
 
 	static constexpr char_type* assign(char_type* s, STD::size_t n, char_type a) {
@@ -103,6 +113,31 @@ CONSTAINER_PURE_CONST constexpr int toupper(int i) {
 }
 
 
+namespace detail {
+	/**< A set of characters given as a range, for the find_*_of members. Characters below 256 are looked up in a
+	     bitmap built once; any others are searched for in the range. */
+	template <typename Char>
+	class CharacterClass {
+		Array<STD::uint64_t, 4> _narrow {};
+		Char const* _first;
+		Char const* _last;
+
+		static constexpr bool _isNarrow(Char c) {return static_cast<STD::make_unsigned_t<Char>>(c) < 256;}
+		static constexpr STD::size_t _index(Char c) {return static_cast<STD::make_unsigned_t<Char>>(c) & 0xFF;}
+
+	public:
+		constexpr CharacterClass(Char const* first, Char const* last) : _first(first), _last(last) {
+			for (; first != last; ++first)
+				if (_isNarrow(*first))
+					_narrow[_index(*first) / 64] |= STD::uint64_t(1) << _index(*first) % 64;
+		}
+
+		constexpr bool operator()(Char c) const {
+			return _isNarrow(c)? _narrow[_index(c) / 64] >> _index(c) % 64 & 1 : Constainer::find(_first, _last, c) != _last;
+		}
+	};
+}
+
 template <typename Char, STD::size_t MaxN, typename Traits=CharTraits<Char>>
 class BasicString : protected detail::BasicVector<Char, MaxN, Traits, 1> {
 
@@ -470,16 +505,58 @@ public:
 		_base::swap(other);
 	}
 
+private:
+
+	/**< Whether traits_type compares characters by value, such that the find members can use TwoWaySearcher and
+	     CharacterClass. */
+	using _by_value = STD::integral_constant<bool, STD::is_same<Traits, CharTraits<Char>>{} && STD::is_integral<Char>{}>;
+
+	static constexpr size_type _short_pattern = 16;
+
+	template <typename It, typename PatternIt>
+	static constexpr It _search(It first, It last, PatternIt s_first, PatternIt s_last, STD::true_type) {
+		return Constainer::search(first, last, s_first, s_last);
+	}
+	template <typename It, typename PatternIt>
+	static constexpr It _search(It first, It last, PatternIt s_first, PatternIt s_last, STD::false_type) {
+		return Constainer::search(first, last, s_first, s_last, traits_type::eq);
+	}
+
+	/**< The first element of [first, last) that is (match) or is not (!match) in [str, str+count). */
+	template <typename It>
+	static constexpr It _find_of(It first, It last, const_pointer str, size_type count, bool match, STD::true_type) {
+		detail::CharacterClass<value_type> const set(str, str+count);
+		while (first != last && set(*first) != match)
+			++first;
+		return first;
+	}
+	template <typename It>
+	static constexpr It _find_of(It first, It last, const_pointer str, size_type count, bool match, STD::false_type) {
+		return match? Constainer::find_first_of    (first, last, str, str+count, traits_type::eq)
+		            : Constainer::find_first_not_of(first, last, str, str+count, traits_type::eq);
+	}
+
+public:
+
 	/**< --------- @FIND ---------*/
 
-	//! TODO: Implement Boyer-Moore.
 	constexpr size_type find(const_pointer str, size_type pos, size_type count) const {
-		if (pos < size()) {
-			auto it = Constainer::search(begin()+pos, end(), str, str+count,
-			                             traits_type::eq);
-			if (it != end())
-				return it-begin();
+		if (count == 0)
+			return pos <= size()? pos : npos;
+		if (pos >= size() || count > size()-pos)
+			return npos;
+		// Short patterns are matched at the occurrences of their first character, which traits_type::find locates
+		// quickly; this costs at most count comparisons per character, and spares setting up a TwoWaySearcher
+		if (count < _short_pattern) {
+			auto first = data()+pos, last = data()+(size()-count+1);
+			for (; (first = traits_type::find(first, last-first, *str)) != nullptr; ++first)
+				if (traits_type::compare(first+1, str+1, count-1) == 0)
+					return first-data();
+			return npos;
 		}
+		auto it = _search(begin()+pos, end(), str, str+count, _by_value{});
+		if (it != end())
+			return it-begin();
 		return npos;
 	}
 	constexpr size_type find(const_pointer str, size_type pos=0) const {
@@ -504,10 +581,9 @@ public:
 			return STD::min(size(), pos);
 		if (!empty()) {
 			pos = STD::min(pos, size()-1);
-			auto it = Constainer::search(rbegin()+(size()-pos-1), rend(),
-			                             Constainer::make_reverse_iterator(str+count),
-			                             Constainer::make_reverse_iterator(str),
-			                             traits_type::eq);
+			auto it = _search(rbegin()+(size()-pos-1), rend(),
+			                  Constainer::make_reverse_iterator(str+count),
+			                  Constainer::make_reverse_iterator(str), _by_value{});
 			if (it != rend())
 				return it.base()-begin()-count;
 		}
@@ -527,7 +603,9 @@ public:
 	/**< --------- @FIND_FIRST_OF ---------*/
 
 	constexpr size_type find_first_of(const_pointer str, size_type pos, size_type count) const {
-		auto it = Constainer::find_first_of(begin()+pos, end(), str, str+count, traits_type::eq);
+		if (pos >= size())
+			return npos;
+		auto it = _find_of(begin()+pos, end(), str, count, true, _by_value{});
 		if (it == end())
 			return npos;
 		return it-begin();
@@ -546,7 +624,9 @@ public:
 	/**< --------- @FIND_FIRST_NOT_OF ---------*/
 
 	constexpr size_type find_first_not_of(const_pointer str, size_type pos, size_type count) const {
-		auto it = Constainer::find_first_not_of(begin()+pos, end(), str, str+count, traits_type::eq);
+		if (pos >= size())
+			return npos;
+		auto it = _find_of(begin()+pos, end(), str, count, false, _by_value{});
 		if (it == end())
 			return npos;
 		return it-begin();
@@ -566,8 +646,10 @@ public:
 	/**< --------- @FIND_LAST_OF ---------*/
 
 	constexpr size_type find_last_of(const_pointer str, size_type pos, size_type count) const {
+		if (empty())
+			return npos;
 		pos = STD::min(pos, size()-1);
-		auto it = Constainer::find_first_of(rbegin()+(size()-pos-1), rend(), str, str+count, traits_type::eq);
+		auto it = _find_of(rbegin()+(size()-pos-1), rend(), str, count, true, _by_value{});
 		if (it.base() == begin())
 			return npos;
 		return it.base()-1-begin();
@@ -586,8 +668,10 @@ public:
 	/**< --------- @FIND_LAST_NOT_OF ---------*/
 
 	constexpr size_type find_last_not_of(const_pointer str, size_type pos, size_type count) const {
+		if (empty())
+			return npos;
 		pos = STD::min(pos, size()-1);
-		auto it = Constainer::find_first_not_of(rbegin()+(size()-pos-1), rend(), str, str+count, traits_type::eq);
+		auto it = _find_of(rbegin()+(size()-pos-1), rend(), str, count, false, _by_value{});
 		if (it.base() == begin())
 			return npos;
 		return it.base()-1-begin();
@@ -600,7 +684,7 @@ public:
 	}
 	template <STD::size_t OtherMax>
 	constexpr size_type find_last_not_of(ThisResized<OtherMax> const& other, size_type pos = npos) const {
-		return find_last_of(other.data(), pos, other.size());
+		return find_last_not_of(other.data(), pos, other.size());
 	}
 };
 
@@ -11,6 +11,8 @@
 #include "StableVector.hxx"
 #include "FlatSet.hxx"
 #include "FlatMap.hxx"
+#include "EytzingerTree.hxx"
+#include "StaticHashMap.hxx"
 #include "StaticPrintf.hxx"
 
 // Check ADL range access
@@ -160,6 +162,142 @@ constexpr auto k() {
 }
 static_assert( k() == StableFlatMultiMap<int, char, 10, STD::greater<>>{{3, 'c'}, {3, 'd'}, {2, 'b'}, {2, 'c'}} );
 
+constexpr auto l() {
+	Vector<int, 100> v{9, 3, 7, 3, 1, 8, 2, 6, 0, 5, 4, 9, 1, 7, 3, 2, 8, 6, 0, 5, 4};
+	sort(begin(v), end(v));
+	assert(is_sorted(begin(v), end(v)));
+	FlatSet<int, 32> set(begin(v)+3, end(v));
+	// 1 2 3 4 5 6 7 8 9
+	set.insert({11, 0, 5, 10, 0});
+	// 0 1 2 3 4 5 6 7 8 9 10 11
+	set.insert(ordered_unique_range, {-2, -1, 4, 12});
+	return set;
+}
+static_assert( l() == FlatSet<int, 20>{-2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12} );
+
+constexpr auto m() {
+	FlatMultiMap<int, char, 64> map{{3, 'a'}, {1, 'b'}, {3, 'b'}, {2, 'a'}, {1, 'a'}};
+	map.insert({{2, 'b'}, {3, 'c'}, {0, 'a'}, {1, 'c'}});
+	map.insert(ordered_range, {{1, 'd'}, {4, 'a'}});
+	return map;
+}
+static_assert( m() == FlatMultiMap<int, char, 20>(ordered_range, {{0, 'a'}, {1, 'b'}, {1, 'a'}, {1, 'c'}, {1, 'd'}, {2, 'a'}, {2, 'b'},
+                                                                  {3, 'a'}, {3, 'b'}, {3, 'c'}, {4, 'a'}}) );
+
+constexpr auto n() {
+	FlatMap<String, int, 32> flat{{"if", 1}, {"else", 2}, {"while", 3}, {"for", 4}, {"do", 5}, {"switch", 6},
+	                              {"case", 7}, {"default", 8}, {"break", 9}, {"continue", 10}, {"return", 11}};
+	StaticHashMap<String, int, 16> map(flat);
+	assert( map.size() == flat.size() );
+	for (auto const& p : flat)
+		assert( map.at(p.key()).value() == p.value() );
+	assert( map.count("goto") == 0 && map.find("els") == map.end() );
+
+	StaticHashSet<int, 64> set{3, 14, 15, 92, 65, 35, 89, 79, 32, 38, 46, 26, 43};
+	return set.count(92) + set.count(0) + map.find("while")->value();
+}
+static_assert( n() == 4 );
+
+/**< Whether F{}() is a constant expression, e.g. does not throw. */
+template <typename F, int = (F{}(), 0)>
+constexpr bool isConstantExpression(int) {return true;}
+template <typename F>
+constexpr bool isConstantExpression(...) {return false;}
+
+struct ModuloHash {constexpr STD::size_t operator()(int i) const {return i % 8;}};
+template <int... keys>
+struct BuildModuloHashSet {
+	constexpr auto operator()() const {return StaticHashSet<int, 16, ModuloHash>{keys...}.size();}
+};
+// 1 and 9 have equal hashes, which no seed separates
+static_assert( isConstantExpression<BuildModuloHashSet<1, 2, 11>>(0) );
+static_assert( !isConstantExpression<BuildModuloHashSet<1, 9, 2>>(0) );
+
+constexpr auto o() {
+	FlatSet<int, 64> flat;
+	for (int i = 0; i < 40; ++i)
+		flat.insert(i*i % 97);
+	EytzingerSet<int, 64> eytz(flat);
+	for (int key = -1; key < 100; ++key) {
+		auto i = eytz.lower_bound(key), j = eytz.upper_bound(key);
+		assert( (i == eytz.end()? flat.end() : flat.find(*i)) == flat.lower_bound(key) );
+		assert( (j == eytz.end()? flat.end() : flat.find(*j)) == flat.upper_bound(key) );
+		assert( eytz.count(key) == flat.count(key) );
+		assert( i == eytz.end() || eytz.successor(i) == eytz.upper_bound(*i) );
+	}
+
+	EytzingerMap<int, char, 8> map{{4, 'd'}, {1, 'a'}, {3, 'c'}, {2, 'b'}};
+	return map.at(3).value();
+}
+static_assert( o() == 'c' );
+
+constexpr auto p() {
+	Bitset<200> b;
+	b.set(STD::size_t{3}, STD::size_t{130});
+	assert( b.count() == 128 && b.find_next(0, true) == 3 );
+	b.flip(60, 70).reset(100, 199);
+	assert( b.count() == 86 && b.find_next(4, false) == 60 && b.find_next(60, true) == 71 );
+	assert( b.find_prev(70, true) == 59 && b.find_prev(99, false) == 70 );
+	assert( b.find_prev(2, true) == b.size() && b.find_next(100, true) == b.size() );
+
+	ChunkPool<int, 300> pool;
+	int* ptrs[224] {};
+	pool.grab_n(150, ptrs);
+	for (int i = 0; i < 150; i += 2)
+		pool.free(ptrs[i]);
+	int* ptr = pool.grab();
+	assert( ptr == ptrs[0] && pool.used() == 76 );
+	pool.grab_n(224, ptrs);
+	assert( !pool.available() );
+	return ptrs[223] == ptr + 299;
+}
+static_assert( p() );
+
+constexpr auto q() {
+	SegmentedStableVector<int, 128> s{0, 99};
+	auto last = s.begin()+1;
+	for (int i = 1; i != 99; ++i)
+		s.insert(last, i);
+	s.insert(s.begin(), {-3, -2, -1});
+	assert( s.size() == 103 && s[3] == 0 && s[102] == 99 && *last == 99 && last - s.begin() == 102 );
+	auto middle = s.begin()+50;
+	assert( *middle == 47 && *s.erase(s.begin()+10, s.begin()+90) == 87 );
+	assert( s.size() == 23 && s[9] == 6 && s[10] == 87 && last == s.end()-1 );
+	for (int i = 0; i != 22; ++i)
+		s.erase(s.begin()+1);
+	return s.size() == 1 && s.front() == -3 && s.begin()+1 == s.end();
+}
+static_assert( q() );
+
+constexpr auto r() {
+	Vector<int, 16> a{1, 2, 3, 4, 5}, b{6};
+	a.swap(b);
+	a.insert(a.begin(), b.begin(), b.begin());
+	String s = "abcdef", t = "xy";
+	s.swap(t);
+	return a.size() == 1 && a[0] == 6 && b.size() == 5 && b[4] == 5
+	    && s == "xy" && s.c_str()[2] == '\0' && t == "abcdef";
+}
+static_assert( r() );
+
+template <STD::size_t n>
+struct ConstructVector {
+	constexpr auto operator()() const {return Vector<int, 8>(n).size();}
+};
+// MaxN-n wrapped around for n > MaxN, which let the size exceed the capacity
+static_assert( isConstantExpression<ConstructVector<8>>(0) && !isConstantExpression<ConstructVector<9>>(0) );
+
+constexpr auto w() {
+	String s = "abcdef";
+	s.erase(3);
+	s += 'x';
+	s.erase(1, 3);
+	s.append(2, 'y');
+	// The characters erased from behind the new end must not show through when the string grows back
+	return s == "ayy" && s.c_str()[3] == '\0';
+}
+static_assert( w() );
+
 
 static_assert( strToInt<int>(" 6849.") == 6849 );
 static_assert( strToInt<signed char>(" -128aefws") == -128 );
@@ -200,3 +338,165 @@ namespace TC001
 
 static_assert( 0.123456789456 == strToFloat<double>("%a\n"_ConstainerStaticPrintf(0.123456789456).c_str()) );
 
+/**< Round-trip corpus: each literal must be printed as itself, i.e. as the shortest representation of its value. */
+struct RoundTrip {
+	double value;
+	char const* shortest;
+};
+constexpr RoundTrip roundTripCorpus[] {
+	{0.1, "0.1"}, {0.3, "0.3"}, {0.3333333333333333, "0.3333333333333333"}, {-0.5, "-0.5"}, {4.35, "4.35"},
+	{100, "100"}, {299792458, "299792458"}, {1e16, "10000000000000000"}, {1e17, "1e+17"}, {0.0001, "0.0001"},
+	{1e-05, "1e-05"}, {2.5e-05, "2.5e-05"}, {1e+23, "1e+23"}, {6.02214076e+23, "6.02214076e+23"},
+	{9007199254740992, "9007199254740992"}, {1.2345678901234568e+17, "1.2345678901234568e+17"},
+	{5e-324, "5e-324"}, {2.2250738585072014e-308, "2.2250738585072014e-308"},
+	{1.7976931348623157e+308, "1.7976931348623157e+308"}, {0, "0"}};
+
+constexpr auto s() {
+	for (auto const& rt : roundTripCorpus)
+		if (toString(rt.value) != rt.shortest)
+			return false;
+	return toString(0.3f) == "0.3" && toString(1.1754944e-38f) == "1.1754944e-38" && toString(1e-45f) == "1e-45"
+	    // Exact decimal expansions and ties
+	    && "%.20e"_ConstainerStaticPrintf(0.1) == "1.00000000000000005551e-01"
+	    && "%.3e"_ConstainerStaticPrintf(5e-324) == "4.941e-324"
+	    && "%.0f %.0f %.0f %.1f %.1f"_ConstainerStaticPrintf(0.5, 1.5, 2.5, 0.25, 0.35) == "0 2 2 0.2 0.3"
+	    && "%f"_ConstainerStaticPrintf(1e22) == "10000000000000000000000.000000"
+	    && "%g %g %.17g %#.3g"_ConstainerStaticPrintf(1e-5, 123456789., 0.1, 999.6) == "1e-05 1.23457e+08 0.10000000000000001 1.00e+03"
+	    // Padding, and a field that exceeds the local buffer and fills the whole string
+	    && "%-8.2f|%10.2e|%=9.1f|%_+8.1f"_ConstainerStaticPrintf(3.14159, -1234.5, 2.25, 2.0) == "3.14    | -1.23e+03|   2.2   |+    2.0"
+	    && "%.0f"_ConstainerStaticPrintf(9e255).size() == 256
+	    && "%d %i %d"_ConstainerStaticPrintf(-42, -9223372036854775807ll-1, 0) == "-42 -9223372036854775808 0";
+}
+static_assert( s() );
+
+
+constexpr auto t() {
+	for (auto const& rt : roundTripCorpus)
+		if (strToFloat<double>(rt.shortest) != rt.value)
+			return false;
+	STD::size_t pos = 0;
+	auto ints = parseDelimited<long long, 8>(" 12345678901234567, -9223372036854775808 ,0\n", 44, ',', &pos);
+	auto reals = parseDelimited<double, 8>("0.1;2.5e-3 ; 1 ", 15, ';');
+	STD::size_t exponent_pos = 0;
+	auto no_exponent = strToFloat<double>("1e+", &exponent_pos);
+	return strToFloat<double>("9007199254740993") == 9007199254740992.
+	    && strToFloat<double>("9007199254740993.00000000000000000000000001") == 9007199254740994.
+	    && strToFloat<double>("2.47032822920623272e-324") == 0 && strToFloat<double>("2.47032822920623273e-324") == 5e-324
+	    && strToFloat<float>("1.00000005960464477539062500") == 1.f && strToFloat<float>("3.4028235e38") == 3.4028235e38f
+	    && strToFloat<double>("1e-400") == 0 && strToFloat<double>("0.000001234567890123456789") == 1.234567890123456789e-6
+	    && strToInt<long long>("-9223372036854775808") == STD::numeric_limits<long long>::min()
+	    && strToInt<unsigned long long>("18446744073709551615") == STD::numeric_limits<unsigned long long>::max()
+	    && ints.size() == 3 && ints[0] == 12345678901234567 && ints[1] == STD::numeric_limits<long long>::min()
+	    && ints[2] == 0 && pos == 44
+	    && reals.size() == 3 && reals[0] == 0.1 && reals[1] == 2.5e-3 && reals[2] == 1
+	    && no_exponent == 1 && exponent_pos == 1;
+}
+static_assert( t() );
+
+
+/**< Compare letters regardless of case, which the skip table of TwoWaySearcher must not be used with. */
+constexpr char toLower(char c) {return c >= 'A' && c <= 'Z'? c - 'A' + 'a' : c;}
+struct EqualNoCase {
+	constexpr bool operator()(char a, char b) const {return toLower(a) == toLower(b);}
+};
+struct LessNoCase {
+	constexpr bool operator()(char a, char b) const {return toLower(a) < toLower(b);}
+};
+
+constexpr auto u() {
+	char const text[] = "GCATCGCAGAGAGTATACAGTACGGCAGAGAGAGAGAGAGAGAGAGAGAGAGAGAGAGAGTATACAGTACG";
+	char const pattern[] = "GCAGAGAG";
+	auto searcher = makeTwoWaySearcher(pattern, pattern+8);
+	auto match = searcher(text, text+sizeof text-1);
+	char const lower_pattern[] = "gcagagag";
+	auto no_case = makeTwoWaySearcher(lower_pattern, lower_pattern+8, EqualNoCase{}, LessNoCase{});
+	int const ints[] {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8, 9, 7, 9, 3, 2, 3, 8, 4, 6, 2, 6, 4, 3, 3, 8, 3, 2, 7, 9, 5},
+	          needle[] {3, 8, 4, 6};
+	String periodic = "abababababababababababababababababababababababababababababababababac-abab";
+	String log = "2016-04-01 12:00:03 [warning] disk usage at 91%; [error] quota exceeded";
+	return match.first == text+5 && match.second == text+13
+	    && Constainer::search(text, text+sizeof text-1, searcher) == text+5
+	    && Constainer::search(text, text+sizeof text-1, no_case) == text+5
+	    && Constainer::search(ints, ints+32, needle, needle+4) == ints+17
+	    && Constainer::search(ints, ints+32, needle+1, needle+4) == ints+18
+	    && periodic.find("ababac") == 62 && periodic.find("abab", 67) == 69 && periodic.find("abac", 0, 3) == 0
+	    && periodic.rfind("abab") == 69 && periodic.rfind("bababa") == 61 && periodic.find("abc") == String::npos
+	    && log.find("[error]") == 49 && log.find_first_of("[]%;") == 20 && log.find_last_of("[]%;") == 55
+	    && log.find_first_not_of("0123456789-") == 10 && log.find_last_not_of("dexc ", 70) == 61
+	    && String("ab\x80").compare("ab\x7F") < 0 && String("abc").compare("abd") < 0 && String("abd").compare("abc") > 0;
+}
+static_assert( u() );
+
+constexpr auto v() {
+	// More duplicates per key than the cutoff below which sorting is done by insertion
+	FlatMap<int, int, 64>::value_type pairs[40] {};
+	for (int i = 0; i != 40; ++i)
+		pairs[i] = {i%3, i};
+	FlatMap<int, int, 64> built(begin(pairs), end(pairs)), inserted{{1, -1}}, single;
+	inserted.insert(begin(pairs), end(pairs));
+	for (auto const& p : pairs)
+		single.insert(p);
+	return built == single && built[0] == 0 && built[1] == 1 && built[2] == 2
+	    && inserted[0] == 0 && inserted[1] == -1 && inserted[2] == 2;
+}
+static_assert( v() );
+
+/**< --------- Runtime tests ---------*/
+
+/**< Counts its live instances, so that a container can be checked to construct and destroy exactly the elements
+     it holds. */
+struct Counted {
+	static int live;
+	int value;
+
+	Counted(int v = 0) : value(v) {++live;}
+	Counted(Counted const& other) : Counted(other.value) {}
+	Counted& operator=(Counted const&) = default;
+	~Counted() {--live;}
+
+	friend void swap(Counted& a, Counted& b) {STD::swap(a.value, b.value);}
+	friend bool operator==(Counted const& a, int b) {return a.value == b;}
+};
+int Counted::live = 0;
+
+using CountedVector = UninitializedVector<Counted, 16>;
+
+/**< Whether v holds the given values. */
+bool holds(CountedVector const& v, STD::initializer_list<int> values) {
+	return Constainer::equal(v.begin(), v.end(), values.begin(), values.end());
+}
+
+bool uninitializedVectorLifetimes() {
+	bool ok = true;
+	{
+		CountedVector a, b;
+		ok &= Counted::live == 0;
+		a.push_back(1);
+		a.push_back(2);
+		a.push_back(4);
+		a.insert(a.begin()+2, 3);
+		ok &= holds(a, {1, 2, 3, 4}) && Counted::live == 4;
+		a.insert(a.begin(), 2, 0);
+		a.erase(a.begin(), a.begin()+3);
+		ok &= holds(a, {2, 3, 4}) && Counted::live == 3;
+		a.resize(5, 5);
+		ok &= holds(a, {2, 3, 4, 5, 5}) && Counted::live == 5;
+		a.resize(2);
+		ok &= holds(a, {2, 3}) && Counted::live == 2;
+
+		b = a;
+		CountedVector c = a, d = STD::move(c);
+		ok &= holds(b, {2, 3}) && holds(d, {2, 3}) && c.empty() && Counted::live == 6;
+		b.push_back(7);
+		b.push_back(8);
+		a.swap(b);
+		ok &= holds(a, {2, 3, 7, 8}) && holds(b, {2, 3}) && Counted::live == 8;
+		d.clear();
+		ok &= Counted::live == 6;
+	}
+	return ok && Counted::live == 0;
+}
+
+int main() {
+	return uninitializedVectorLifetimes()? 0 : 1;
+}
@@ -57,4 +57,8 @@ constexpr bool operator<=(BasicVector<T1, Size1, Traits1> const& lhs, BasicVecto
 template <typename T, STD::size_t N=defaultContainerSize>
 using Vector = BasicVector<T, N, DefaultCopyTraits<T>>;
 
+/**< For use at runtime only: doesn't construct the elements beyond size(), see UninitializedCopyTraits. */
+template <typename T, STD::size_t N=defaultContainerSize>
+using UninitializedVector = BasicVector<T, N, UninitializedCopyTraits<T>>;
+
 }
@@ -71,6 +71,156 @@ template <typename Input1, typename Input2>
 constexpr bool equal( Input1 first1, Input1 last1, Input2 first2, Input2 last2 ) {
 	return Constainer::equal(first1, last1, first2, last2, STD::equal_to<>{});}
 
+/**< A searcher for use with search, in the style of STD::boyer_moore_searcher, that implements the Two-Way algorithm of
+     Crochemore and Perrin: it takes linear time in the worst case and needs constant extra space. pred and comp must be
+     consistent, i.e. elements equal by pred must be equivalent under comp. For integral elements compared with
+     STD::equal_to, a mismatch of the element aligned with the end of the pattern shifts the pattern as in
+     Boyer-Moore-Horspool, which makes common searches sublinear; the shift table is indexed by the lowest eight bits.
+     Other predicates may consider elements equal that differ in those bits, hence they do without it. */
+template <typename RandomIt1, typename BinaryPredicate = STD::equal_to<>, typename Compare = STD::less<>>
+class TwoWaySearcher {
+	using _value_type = typename STD::iterator_traits<RandomIt1>::value_type;
+	static constexpr bool _use_skip = STD::is_integral<_value_type>{}
+	                               && (STD::is_same<BinaryPredicate, STD::equal_to<>>{}
+	                                || STD::is_same<BinaryPredicate, STD::equal_to<_value_type>>{});
+
+	RandomIt1 _first;
+	STD::size_t _length = 0,
+	            _split = 0,  // The critical position: the pattern is matched from here to the end, then backwards
+	            _period = 0, // The shift after a match of the right part
+	            _memory = 0; // The length of the prefix known to match after that shift, for periodic patterns
+	STD::uint8_t _skip[256] {};
+	BinaryPredicate _pred;
+	Compare _comp;
+
+	template <typename T>
+	static constexpr STD::size_t _skipIndex(T const& v) {return static_cast<STD::make_unsigned_t<T>>(v) & 0xFF;}
+	static constexpr STD::size_t _skipIndex(bool v) {return v;}
+
+	struct _greater {
+		Compare comp;
+		constexpr bool operator()(_value_type const& a, _value_type const& b) const {return comp(b, a);}
+	};
+
+	/**< Returns the end of the maximal suffix of the pattern under less, and stores its period in period. */
+	template <typename Less>
+	constexpr STD::size_t _maximalSuffix(Less less, STD::size_t& period) const {
+		STD::size_t i = 0, j = 1, k = 0, p = 1; // Offset by one, so that i = 0 is the empty prefix
+		while (j + k < _length) {
+			auto const& a = _first[i + k],
+			          & b = _first[j + k];
+			if (_pred(a, b)) {
+				if (k + 1 == p) {
+					j += p;
+					k = 0;
+				}
+				else
+					++k;
+			}
+			else if (less(b, a)) {
+				j += k + 1;
+				k = 0;
+				p = j - i;
+			}
+			else {
+				i = j++;
+				k = 0;
+				p = 1;
+			}
+		}
+		period = p;
+		return i;
+	}
+
+public:
+
+	constexpr TwoWaySearcher( RandomIt1 pat_first, RandomIt1 pat_last,
+	                          BinaryPredicate pred = BinaryPredicate(), Compare comp = Compare() )
+		: _first(pat_first), _length(pat_last - pat_first), _pred(pred), _comp(comp) {
+		if (_length == 0)
+			return;
+
+		// The critical factorisation is given by the later of the maximal suffixes under the order and its inverse
+		STD::size_t period = 0, inverse_period = 0;
+		auto split = _maximalSuffix(_comp, period),
+		     inverse_split = _maximalSuffix(_greater{_comp}, inverse_period);
+		if (inverse_split > split) {
+			split = inverse_split;
+			period = inverse_period;
+		}
+		_split = split;
+
+		// If the left part recurs a period later, that is the pattern's period; otherwise, a shift by the longer of
+		// the two parts, plus one, is safe
+		STD::size_t i = 0;
+		while (i < split && _pred(_first[i], _first[i + period]))
+			++i;
+		if (i == split) {
+			_period = period;
+			_memory = _length - period;
+		}
+		else
+			_period = (split-1 > _length - split? split-1 : _length - split) + 1;
+
+		if (_use_skip) {
+			for (auto& s : _skip)
+				s = static_cast<STD::uint8_t>(_length < 255? _length : 255);
+			for (i = 0; i < _length; ++i)
+				_skip[_skipIndex(_first[i])] = static_cast<STD::uint8_t>(_length-1 - i < 255? _length-1 - i : 255);
+		}
+	}
+
+	/**< Returns the first occurrence of the pattern in [first, last) as a pair of iterators, or {last, last}. */
+	template <typename RandomIt2>
+	constexpr STD::pair<RandomIt2, RandomIt2> operator()(RandomIt2 first, RandomIt2 last) const {
+		if (_length == 0)
+			return {first, first};
+
+		STD::size_t memory = 0;
+		for (;;) {
+			if (static_cast<STD::size_t>(last - first) < _length)
+				return {last, last};
+
+			if (_use_skip) {
+				STD::size_t k = _skip[_skipIndex(first[_length-1])];
+				if (k != 0) {
+					first += k < memory? memory : k;
+					memory = 0;
+					continue;
+				}
+			}
+
+			// Match the right part, then the left one
+			auto k = _split < memory? memory : _split;
+			while (k < _length && _pred(_first[k], first[k]))
+				++k;
+			if (k < _length) {
+				first += k - _split + 1;
+				memory = 0;
+				continue;
+			}
+			k = _split;
+			while (k > memory && _pred(_first[k-1], first[k-1]))
+				--k;
+			if (k <= memory)
+				return {first, first + _length};
+			first += _period;
+			memory = _memory;
+		}
+	}
+};
+
+template <typename RandomIt1, typename BinaryPredicate = STD::equal_to<>, typename Compare = STD::less<>>
+constexpr auto makeTwoWaySearcher( RandomIt1 pat_first, RandomIt1 pat_last,
+                                   BinaryPredicate pred = BinaryPredicate(), Compare comp = Compare() ) {
+	return TwoWaySearcher<RandomIt1, BinaryPredicate, Compare>(pat_first, pat_last, pred, comp);
+}
+
+template <typename ForwardIt, typename Searcher>
+constexpr ForwardIt search(ForwardIt first, ForwardIt last, Searcher const& searcher) {
+	return searcher(first, last).first;
+}
+
 template <typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
 constexpr ForwardIt1 search(ForwardIt1 first, ForwardIt1 last,
                             ForwardIt2 s_first, ForwardIt2 s_last,
@@ -89,10 +239,31 @@ constexpr ForwardIt1 search(ForwardIt1 first, ForwardIt1 last,
 		}
 	}
 }
-template <typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
+
+namespace detail {
+	template <typename ForwardIt1, typename ForwardIt2>
+	constexpr ForwardIt1 search(ForwardIt1 f, ForwardIt1 l, ForwardIt2 sf, ForwardIt2 sl, STD::false_type) {
+		return Constainer::search(f, l, sf, sl, STD::equal_to<>{});}
+	template <typename RandomIt1, typename RandomIt2>
+	constexpr RandomIt1 search(RandomIt1 f, RandomIt1 l, RandomIt2 sf, RandomIt2 sl, STD::true_type) {
+		// Patterns of one or two elements, or short ranges, don't amortise the searcher's construction
+		if (sl - sf < 3 || l - f < 64)
+			return Constainer::search(f, l, sf, sl, STD::equal_to<>{});
+		return TwoWaySearcher<RandomIt2>(sf, sl)(f, l).first;
+	}
+}
+
+/**< Uses TwoWaySearcher for random access ranges of the same integral type, and the element-wise search otherwise. */
+template <typename ForwardIt1, typename ForwardIt2>
 constexpr ForwardIt1 search(ForwardIt1 f, ForwardIt1 l,
                             ForwardIt2 sf, ForwardIt2 sl) {
-	return search(f, l, sf, sl, STD::equal_to<>{});}
+	using value_type = typename STD::iterator_traits<ForwardIt1>::value_type;
+	return detail::search(f, l, sf, sl, STD::integral_constant<bool, isRandomAccessIterator<ForwardIt1>{}
+	                                                                && isRandomAccessIterator<ForwardIt2>{}
+	                                                                && STD::is_integral<value_type>{}
+	                                                                && STD::is_same<value_type,
+	                                                                       typename STD::iterator_traits<ForwardIt2>::value_type>{}>{});
+}
 
 
 
@@ -0,0 +1,189 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "NonModifying.hxx"
+#include "Transformations.hxx"
+
+namespace Constainer {
+
+template <typename ForwardIt, typename Compare>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare comp) {
+	if (first != last)
+		for (auto next = first; ++next != last; first = next)
+			if (comp(*next, *first))
+				return next;
+	return last;
+}
+template <typename ForwardIt>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+	return Constainer::is_sorted_until(first, last, STD::less<>{});}
+
+template <typename ForwardIt, typename Compare>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
+	return Constainer::is_sorted_until(first, last, comp) == last;}
+template <typename ForwardIt>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last) {
+	return Constainer::is_sorted(first, last, STD::less<>{});}
+
+namespace detail {
+	/**< Ranges of at most this length are finished off by insertion sort. */
+	static constexpr STD::ptrdiff_t sortThreshold = 16;
+
+	template <typename RandomIt, typename Compare>
+	constexpr void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+		if (first == last)
+			return;
+		for (auto i = first+1; i != last; ++i) {
+			auto val = STD::move(*i);
+			auto j = i;
+			for (; j != first && comp(val, j[-1]); --j)
+				*j = STD::move(j[-1]);
+			*j = STD::move(val);
+		}
+	}
+
+	template <typename RandomIt, typename Diff, typename Compare>
+	constexpr void sift_down(RandomIt first, Diff len, Diff root, Compare comp) {
+		auto val = STD::move(first[root]);
+		for (Diff child; (child = 2*root + 1) < len; root = child) {
+			if (child+1 < len && comp(first[child], first[child+1]))
+				++child;
+			if (!comp(val, first[child]))
+				break;
+			first[root] = STD::move(first[child]);
+		}
+		first[root] = STD::move(val);
+	}
+
+	template <typename RandomIt, typename Compare>
+	constexpr void heap_sort(RandomIt first, RandomIt last, Compare comp) {
+		auto len = last - first;
+		for (auto i = len/2; i-- > 0;)
+			detail::sift_down(first, len, i, comp);
+		while (len-- > 1) {
+			Constainer::iter_swap(first, first+len);
+			detail::sift_down(first, len, decltype(len)(0), comp);
+		}
+	}
+
+	/**< Moves the median of *a, *b and *c into *result. */
+	template <typename RandomIt, typename Compare>
+	constexpr void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+		if (comp(*a, *b)) {
+			if      (comp(*b, *c)) Constainer::iter_swap(result, b);
+			else if (comp(*a, *c)) Constainer::iter_swap(result, c);
+			else                   Constainer::iter_swap(result, a);
+		}
+		else if (comp(*a, *c))     Constainer::iter_swap(result, a);
+		else if (comp(*b, *c))     Constainer::iter_swap(result, c);
+		else                       Constainer::iter_swap(result, b);
+	}
+
+	/**< Hoare partition of [first, last) around *pivot, which must lie outside of that range. */
+	template <typename RandomIt, typename Compare>
+	constexpr RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp) {
+		for (;;) {
+			while (comp(*first, *pivot))
+				++first;
+			--last;
+			while (comp(*pivot, *last))
+				--last;
+			if (!(first < last))
+				return first;
+			Constainer::iter_swap(first, last);
+			++first;
+		}
+	}
+
+	template <typename RandomIt, typename Compare>
+	constexpr void introsort_loop(RandomIt first, RandomIt last, int depth_limit, Compare comp) {
+		while (last - first > sortThreshold) {
+			if (depth_limit-- == 0) {
+				detail::heap_sort(first, last, comp);
+				return;
+			}
+			detail::move_median_to_first(first, first+1, first + (last-first)/2, last-1, comp);
+			auto cut = detail::unguarded_partition(first+1, last, first, comp);
+			detail::introsort_loop(cut, last, depth_limit, comp);
+			last = cut;
+		}
+	}
+
+	/**< Merges [first, middle) and [middle, last) by recursive rotation, without any working memory.
+	     Derived from the corresponding part of libstdc++'s inplace_merge. */
+	template <typename BidirIt, typename Diff, typename Compare>
+	constexpr void merge_without_buffer(BidirIt first, BidirIt middle, BidirIt last,
+	                                    Diff len1, Diff len2, Compare comp) {
+		if (len1 == 0 || len2 == 0 || !comp(*middle, *Constainer::prev(middle)))
+			return;
+		if (len1 + len2 == 2) {
+			Constainer::iter_swap(first, middle);
+			return;
+		}
+
+		auto first_cut = first, second_cut = middle;
+		Diff len11 = 0, len22 = 0;
+		if (len1 > len2) {
+			len11 = len1 / 2;
+			Constainer::advance(first_cut, len11);
+			second_cut = Constainer::lower_bound(middle, last, *first_cut, comp);
+			len22 = Constainer::distance(middle, second_cut);
+		}
+		else {
+			len22 = len2 / 2;
+			Constainer::advance(second_cut, len22);
+			first_cut = Constainer::upper_bound(first, middle, *second_cut, comp);
+			len11 = Constainer::distance(first, first_cut);
+		}
+		Constainer::rotate(first_cut, middle, second_cut);
+		auto new_middle = Constainer::next(first_cut, len22);
+		detail::merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+		detail::merge_without_buffer(new_middle, second_cut, last, len1 - len11, len2 - len22, comp);
+	}
+}
+
+/**< Introsort: quicksort with median-of-three pivots that falls back to heap sort
+     once the recursion gets too deep, so it is O(N log N) in the worst case. */
+template <typename RandomIt, typename Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp) {
+	int depth_limit = 0;
+	for (auto n = last - first; n > 1; n /= 2)
+		depth_limit += 2;
+	detail::introsort_loop(first, last, depth_limit, comp);
+	detail::insertion_sort(first, last, comp);
+}
+template <typename RandomIt>
+constexpr void sort(RandomIt first, RandomIt last) {
+	Constainer::sort(first, last, STD::less<>{});}
+
+/**< Stable merge of the consecutive sorted ranges [first, middle) and [middle, last).
+     Needs no working memory; costs O(N log N) moves and returns after one comparison
+     if the ranges are already in order. */
+template <typename BidirIt, typename Compare>
+constexpr void inplace_merge(BidirIt first, BidirIt middle, BidirIt last, Compare comp) {
+	detail::merge_without_buffer(first, middle, last,
+	                             Constainer::distance(first, middle), Constainer::distance(middle, last), comp);
+}
+template <typename BidirIt>
+constexpr void inplace_merge(BidirIt first, BidirIt middle, BidirIt last) {
+	Constainer::inplace_merge(first, middle, last, STD::less<>{});}
+
+/**< Bottom-up merge sort over insertion-sorted runs. Without working memory this is
+     O(N log² N) in the worst case, but O(N) for input that is already sorted. */
+template <typename RandomIt, typename Compare>
+constexpr void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+	auto len = last - first;
+	for (decltype(len) i = 0; i < len; i += detail::sortThreshold)
+		detail::insertion_sort(first+i, first + STD::min(i + detail::sortThreshold, len), comp);
+	for (decltype(len) width = detail::sortThreshold; width < len; width *= 2)
+		for (decltype(len) i = 0; i + width < len; i += 2*width)
+			Constainer::inplace_merge(first+i, first+i+width, first + STD::min(i + 2*width, len), comp);
+}
+template <typename RandomIt>
+constexpr void stable_sort(RandomIt first, RandomIt last) {
+	Constainer::stable_sort(first, last, STD::less<>{});}
+
+}
@@ -196,6 +196,9 @@ constexpr OutputIt reverse_copy(BidirIt first, BidirIt last, OutputIt out)
 template <typename ForwardIt>
 constexpr void rotate(ForwardIt first, ForwardIt new_first, ForwardIt last)
 {
+	if (first == new_first || new_first == last)
+		return;
+
 	auto next = new_first;
 	while (first != next) {
 		Constainer::iter_swap(first++, next++);
@@ -6,11 +6,75 @@
 
 #include "../Array.hxx"
 #include "../Assert.hxx"
+#include "Stats.hxx"
 
 #include <algorithm>
+#include <cstring> // memcpy, memmove
+#include <new>
 
 namespace Constainer {
 
+namespace detail {
+	/**< Only instantiated for trivially copyable types, see copyElements and friends. */
+	template <typename T>
+	T* memCopy(T* s1, T const* s2, STD::size_t n) {
+		if (n != 0)
+			STD::memcpy(s1, s2, n*sizeof(T));
+		return s1 + n;
+	}
+	/**< The ranges may overlap. */
+	template <typename T>
+	T* memMove(T* s1, T const* s2, STD::size_t n) {
+		if (n != 0)
+			STD::memmove(s1, s2, n*sizeof(T));
+		return s1 + n;
+	}
+
+	/**< At runtime, ranges of trivially copyable types are copied with memcpy and memmove. The element-wise
+	     loops remain as the implementation for constant expressions and for all other types; the choice between
+	     the two is made by tag dispatch on is_trivially_copyable, such that the mem* calls are never instantiated
+	     for the latter. */
+	template <typename T>
+	using CopyBitwise = STD::is_trivially_copyable<T>;
+
+	template <typename T>
+	constexpr T* copyElements(T* s1, T const* s2, STD::size_t n, STD::true_type) {
+		if (!isConstantEvaluated())
+			return memCopy(s1, s2, n);
+		return Constainer::copy_n(s2, n, s1);
+	}
+	template <typename T>
+	constexpr T* copyElements(T* s1, T const* s2, STD::size_t n, STD::false_type) {
+		return Constainer::copy_n(s2, n, s1);
+	}
+
+	/**< s1 may point into [s2, s2+n). */
+	template <typename T>
+	constexpr T* moveElements(T* s1, T const* s2, STD::size_t n, STD::true_type) {
+		if (!isConstantEvaluated())
+			return memMove(s1, s2, n);
+		return Constainer::move_n(s2, n, s1);
+	}
+	template <typename T>
+	constexpr T* moveElements(T* s1, T const* s2, STD::size_t n, STD::false_type) {
+		return Constainer::move_n(s2, n, s1);
+	}
+
+	/**< Moves [first, last) such that it ends at d_last, which may lie within it. */
+	template <typename T>
+	constexpr void moveElementsBackward(T* first, T* last, T* d_last, STD::true_type) {
+		if (!isConstantEvaluated())
+			memMove(d_last - (last - first), first, last - first);
+		else
+			Constainer::move_backward(first, last, d_last);
+	}
+	template <typename T>
+	constexpr void moveElementsBackward(T* first, T* last, T* d_last, STD::false_type) {
+		// TODO: Implement move_backward that uses CopyTraits::assign
+		Constainer::move_backward(first, last, d_last);
+	}
+}
+
 template <typename T>
 struct DefaultCopyTraits {
 	using value_type = T;
@@ -20,12 +84,12 @@ struct DefaultCopyTraits {
 	using const_reference = T const&;
 
 	static constexpr pointer copy(pointer s1, const_pointer s2, STD::size_t n) {
-		return Constainer::copy_n(s2, n, s1);
+		return detail::copyElements(s1, s2, n, detail::CopyBitwise<T>{});
 	}
 
-	/**< This function is called to actually 'move', not copy. */
+	/**< This function is called to actually 'move', not copy. s1 may point into [s2, s2+n). */
 	static constexpr pointer move(pointer s1, const_pointer s2, STD::size_t n) {
-		return Constainer::move_n(s2, n, s1);
+		return detail::moveElements(s1, s2, n, detail::CopyBitwise<T>{});
 	}
 
 	static constexpr pointer assign(pointer s, STD::size_t n, const_reference a) {
@@ -41,17 +105,109 @@ struct DefaultCopyTraits {
 	}
 };
 
+/**< Copy traits for vectors that leave their storage beyond size() unconstructed: elements are constructed
+     when they are added and destroyed when they are erased, instead of the whole capacity being initialised
+     along with the vector. The storage is a union, whence such vectors cannot be used in constant expressions. */
+template <typename T>
+struct UninitializedCopyTraits : DefaultCopyTraits<T> {
+	static constexpr bool uninitialized_storage = true;
+};
+
 }
 
+namespace Constainer { namespace detail {
+
+template <typename CopyTraits, typename=void>
+struct usesUninitializedStorage : STD::false_type {};
+template <typename CopyTraits>
+struct usesUninitializedStorage<CopyTraits, void_t<decltype(CopyTraits::uninitialized_storage)>>
+	: STD::integral_constant<bool, CopyTraits::uninitialized_storage> {};
+
+/**< The storage of BasicVector, holding the size as well. All elements are alive at any time. */
+template <typename T, STD::size_t N>
+struct ConstructedStorage : Array<T, N> {
+	STD::size_t _size = 0;
+
+	constexpr ConstructedStorage() : Array<T, N>{} {}
+
+	static constexpr void _construct(T*, STD::size_t) {}
+	static constexpr void _destroy(T*, STD::size_t) {}
+};
+
+/**< Storage whose elements only live in [0, _size). */
+template <typename T, STD::size_t N>
+struct UninitializedStorage {
+	using size_type = STD::size_t;
+	static constexpr auto size() {return N;}
+
+	using difference_type = STD::ptrdiff_t;
+
+	using value_type = T;
+
+	using         pointer = value_type      *;
+	using   const_pointer = value_type const*;
+
+	using       reference = value_type      &;
+	using const_reference = value_type const&;
+
+	using       iterator =       pointer;
+	using const_iterator = const_pointer;
+
+	using const_reverse_iterator = Constainer::reverse_iterator<const_iterator>;
+	using       reverse_iterator = Constainer::reverse_iterator<      iterator>;
+
+	union {
+		char _none;
+		T _storage[STD::max(size(), {1})];
+	};
+	size_type _size = 0;
+
+	UninitializedStorage() : _none() {}
+	UninitializedStorage(UninitializedStorage const&) = delete;
+	~UninitializedStorage() {_destroy(data(), _size);}
+
+	pointer       data()       {return _storage;}
+	const_pointer data() const {return _storage;}
+
+	      reference front()       {return *begin();}
+	const_reference front() const {return *begin();}
+
+	iterator        begin()       {return _storage;}
+	const_iterator  begin() const {return _storage;}
+	const_iterator cbegin() const {return begin();}
+
+	reverse_iterator        rend()       {return       reverse_iterator(begin());}
+	const_reverse_iterator  rend() const {return const_reverse_iterator(begin());}
+	const_reverse_iterator crend() const {return rend();}
+
+	reference       operator[](size_type index)       {return _storage[index];}
+	const_reference operator[](size_type index) const {return _storage[index];}
+
+	static void _construct(pointer p, size_type n) {
+		for (; n--; ++p)
+			::new (static_cast<void*>(p)) T();
+	}
+	static void _destroy(pointer p, size_type n) {
+		for (; n--; ++p)
+			p->~T();
+	}
+};
+
+template <typename T, STD::size_t N, typename CopyTraits>
+using VectorStorage = STD::conditional_t<usesUninitializedStorage<CopyTraits>{}, UninitializedStorage<T, N>,
+                                                                                ConstructedStorage<T, N>>;
+
+}}
+
 namespace Constainer { namespace detail{
 
 template <typename T, STD::size_t MaxN, typename CopyTraits, STD::size_t addBufferSize>
-class BasicVector : private Array<T, MaxN+addBufferSize> {
+class BasicVector : private VectorStorage<T, MaxN+addBufferSize, CopyTraits> {
 
 	template <typename, STD::size_t, typename, STD::size_t>
 	friend class BasicVector;
 
-	using _base = Array<T, MaxN+addBufferSize>;
+	using _base = VectorStorage<T, MaxN+addBufferSize, CopyTraits>;
 
 public:
 	using traits_type = CopyTraits;
@@ -87,23 +243,40 @@ private:
 
 protected:
 
-	size_type _size = 0;
+	using _base::_size;
 
 	constexpr auto _data() {return this->_storage;}
 
 	constexpr void _verifySizeInc(size_type n) const {
-		AssertExcept<STD::length_error>( size() <= MaxN-n, "Invalid attempt to increase container size" );
+		AssertExcept<STD::length_error>( n <= MaxN-size(), "Invalid attempt to increase container size" );
+	}
+	/**< The additional buffer, if any, holds a value-initialised element behind the last one, e.g. the
+	     terminator of a string. Erasure only restores it at the new end, hence growth has to renew it. */
+	constexpr void _terminate(STD::true_type) {_data()[_size] = value_type();}
+	constexpr void _terminate(STD::false_type) {}
+
+	/**< Constructs n elements at the end. */
+	constexpr void _grow(size_type n) {
+		_base::_construct(end(), n);
+		_size += n;
+		_terminate(STD::integral_constant<bool, addBufferSize != 0>{});
 	}
 	constexpr void _verifiedSizeInc(size_type n) {
-		_verifySizeInc(n); _size += n;
+		_verifySizeInc(n); _grow(n);
+	}
+	/**< Destroys the last n elements. */
+	constexpr void _shrink(size_type n) {
+		_size -= n;
+		_base::_destroy(end(), n);
 	}
 
 	constexpr void _createInsertionSpace(const_iterator pos, size_type len) {
 		assert(pos <= end());
 		_verifiedSizeInc(len);
-		if (pos != end()-len)
-			// TODO: Implement move_backward that uses CopyTraits::assign
-			Constainer::move_backward(_address(pos), end()-len, end());
+		if (len == 0 || pos == end()-len)
+			return;
+		countStat(&Stats::moves, end()-len-pos);
+		moveElementsBackward(_address(pos), end()-len, end(), CopyBitwise<value_type>{});
 	}
 
 public:
@@ -119,10 +292,10 @@ public:
 	constexpr auto size() const {return _size;}
 	constexpr bool empty() const {return size() == 0;}
 
-	constexpr BasicVector() :_base{},  _size(0) {}
+	constexpr BasicVector() : _base{} {}
 
-	constexpr explicit BasicVector( size_type n ) : _base{}, _size(n) {
-		_verifySizeInc(0); // The INCREASE is 0, not the size to test!
+	constexpr explicit BasicVector( size_type n ) : _base{} {
+		_verifiedSizeInc(n);
 	}
 
 	constexpr BasicVector( size_type n, value_type const& v ) : BasicVector(0) {
@@ -224,9 +397,8 @@ private:
 
 	template <typename U>
 	constexpr void _push_back( U&& u ) {
-		_verifySizeInc(1);
-		traits_type::assign(*this->end(), STD::forward<U>(u));
-		++_size;
+		_verifiedSizeInc(1);
+		traits_type::assign(back(), STD::forward<U>(u));
 	}
 
 public:
@@ -244,9 +416,10 @@ public:
 	}
 
 	constexpr iterator erase( const_iterator first, const_iterator last ) {
+		countStat(&Stats::moves, end()-last);
 		traits_type::move( _address(first), _address(last), end() - last);
 		traits_type::destroy(end() - (last-first), last-first);
-		_size -= last-first;
+		_shrink(last-first);
 		return _remcv(first);
 	}
 	constexpr iterator erase( const_iterator it ) {
@@ -263,10 +436,19 @@ private:
 		return pos;
 	}
 
+	template <typename InputIt>
+	constexpr void _copy_n( InputIt first, size_type n, iterator pos, STD::false_type ) {
+		Constainer::copy_n( first, n, pos );
+	}
+	constexpr void _copy_n( const_pointer first, size_type n, iterator pos, STD::true_type ) {
+		traits_type::copy( pos, first, n );
+	}
+
 	template <typename InputIt>
 	constexpr iterator _insert_n( iterator pos, size_type n, InputIt first ) {
 		_createInsertionSpace(pos, n);
-		copy_n( first, n, pos );
+		_copy_n( first, n, pos, STD::integral_constant<bool, STD::is_same<InputIt, pointer      >{}
+		                                                   || STD::is_same<InputIt, const_pointer>{}>{} );
 		return pos;
 	}
 	template <typename ForwardIt>
@@ -345,12 +527,18 @@ public:
 		Constainer::swap_ranges(other.begin(), other.begin() + min, begin());
 
 		// Use the trait of the destination string
-		if (other.size() > size())
-			traits_type::move(_address(begin()+min), _address(other.begin()+min), other.end() - (other.begin() + min));
-		else
-			OtherTraits::move(_address(other.begin()+min), _address(begin()+min), end() - (begin() + min));
-
-		Constainer::swap(_size, other._size);
+		if (other.size() > size()) {
+			auto n = other.size() - min;
+			_grow(n);
+			traits_type::move(_address(begin()+min), _address(other.begin()+min), n);
+			other.erase(other.begin()+min, other.end());
+		}
+		else {
+			auto n = size() - min;
+			other._grow(n);
+			OtherTraits::move(other._address(other.begin()+min), _address(begin()+min), n);
+			erase(begin()+min, end());
+		}
 	}
 
 	constexpr void resize(size_type n, const_reference value) {
@@ -0,0 +1,619 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "../Array.hxx"
+#include "RyuTables.hxx"
+
+#include <cstdint>
+#include <limits>
+
+namespace Constainer { namespace detail {
+
+/**< Whether Float is handled by the decimal conversions below, i.e. whether it has the format of an IEEE single or double. */
+template <typename Float>
+using isDecimalFormattable = STD::integral_constant<bool, STD::numeric_limits<Float>::is_iec559
+                                                           && ((STD::numeric_limits<Float>::digits == 24 && sizeof(Float) == 4)
+                                                            || (STD::numeric_limits<Float>::digits == 53 && sizeof(Float) == 8))>;
+
+/**< A finite binary floating-point value (-1)^negative * mantissa * 2^exponent. Normal values have precision significant
+     bits in mantissa; subnormal ones have fewer and the smallest exponent. lower_boundary_closer is set for powers of two
+     whose predecessor is half as far away as their successor, i.e. all but the smallest normal one. */
+struct BinaryFloat {
+	STD::uint64_t mantissa = 0;
+	int exponent = 0;
+	int precision = 0;
+	bool negative = false;
+	bool lower_boundary_closer = false;
+
+	constexpr bool normal() const {return mantissa >> (precision-1) != 0;}
+};
+
+/**< Decomposes a finite v. The object representation is read through bit_cast where available; otherwise the
+     exponent is found by scaling with powers of two, which is exact, but cannot tell -0 from 0. */
+template <typename Float>
+constexpr BinaryFloat decompose(Float v) {
+	static_assert(isDecimalFormattable<Float>{}, "Only IEEE single and double precision values can be decomposed");
+
+	constexpr int precision = STD::numeric_limits<Float>::digits,
+	              min_exponent = STD::numeric_limits<Float>::min_exponent - precision;
+	BinaryFloat b {0, min_exponent, precision, false, false};
+#ifdef CONSTAINER_HAS_BIT_CAST
+	using bits_type = STD::conditional_t<sizeof(Float) == 4, STD::uint32_t, STD::uint64_t>;
+	constexpr int bits = sizeof(Float)*CHAR_BIT;
+	constexpr auto fraction_mask = (STD::uint64_t(1) << (precision-1)) - 1;
+
+	STD::uint64_t repr = bit_cast<bits_type>(v);
+	int biased_exponent = (repr >> (precision-1)) & ((1 << (bits-precision)) - 1);
+	b.negative = repr >> (bits-1);
+	b.mantissa = repr & fraction_mask;
+	if (biased_exponent != 0) {
+		b.lower_boundary_closer = b.mantissa == 0 && biased_exponent > 1;
+		b.mantissa |= fraction_mask + 1;
+		b.exponent += biased_exponent - 1;
+	}
+#else
+	if (v < 0) {
+		b.negative = true;
+		v = -v;
+	}
+	if (v == 0)
+		return b;
+
+	constexpr auto top = STD::uint64_t(1) << precision;
+	Float const step = 18446744073709551616.0; // 2^64
+	int e = 0;
+	while (v >= top*step) {v /= step; e += 64;}
+	while (v >= top)      {v /= 2;    ++e;}
+	while (v*step < top)  {v *= step; e -= 64;}
+	while (v*2 < top)     {v *= 2;    --e;}
+	b.mantissa = static_cast<STD::uint64_t>(v);
+	if (e < min_exponent) {
+		b.mantissa >>= min_exponent - e;
+		e = min_exponent;
+	}
+	b.exponent = e;
+	b.lower_boundary_closer = b.mantissa == top/2 && e != min_exponent;
+#endif
+	return b;
+}
+
+/**< The decimal value digits * 10^exponent. */
+struct DecimalFloat {
+	STD::uint64_t digits = 0;
+	int exponent = 0;
+};
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+/**< Returns the lower half of the 128-bit product of a and b, and stores the upper half in high. */
+constexpr STD::uint64_t umul128(STD::uint64_t a, STD::uint64_t b, STD::uint64_t& high) {
+#ifdef __SIZEOF_INT128__
+	auto product = static_cast<uint128>(a) * b;
+	high = static_cast<STD::uint64_t>(product >> 64);
+	return static_cast<STD::uint64_t>(product);
+#else
+	STD::uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32,
+	              b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+	auto lo_lo = a_lo*b_lo,
+	     mid1  = a_hi*b_lo + (lo_lo >> 32),
+	     mid2  = a_lo*b_hi + (mid1 & 0xFFFFFFFF);
+	high = a_hi*b_hi + (mid1 >> 32) + (mid2 >> 32);
+	return (mid2 << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+/**< (m * mul) >> j for a {low, high} table entry mul and 64 < j < 128. */
+constexpr STD::uint64_t mulShift64(STD::uint64_t m, STD::uint64_t const* mul, int j) {
+	STD::uint64_t high0 = 0, high1 = 0;
+	umul128(m, mul[0], high0);
+	auto low1 = umul128(m, mul[1], high1);
+	auto sum = high0 + low1;
+	if (sum < high0)
+		++high1;
+	return (high1 << (128-j)) | (sum >> (j-64));
+}
+
+/**< ceil(log2(5^e)) for 0 < e <= 3528, and 1 for e == 0. */
+constexpr int pow5Bits(int e) {return static_cast<int>((static_cast<STD::uint32_t>(e) * 1217359) >> 19) + 1;}
+/**< floor(log10(2^e)) for 0 <= e <= 1650. */
+constexpr int log10Pow2(int e) {return static_cast<int>((static_cast<STD::uint32_t>(e) * 78913) >> 18);}
+/**< floor(log10(5^e)) for 0 <= e <= 2620. */
+constexpr int log10Pow5(int e) {return static_cast<int>((static_cast<STD::uint32_t>(e) * 732923) >> 20);}
+
+constexpr bool multipleOfPowerOf5(STD::uint64_t v, int p) {
+	while (p-- > 0) {
+		if (v % 5 != 0)
+			return false;
+		v /= 5;
+	}
+	return true;
+}
+constexpr bool multipleOfPowerOf2(STD::uint64_t v, int p) {return (v & ((STD::uint64_t(1) << p) - 1)) == 0;}
+
+template <typename=void>
+struct PowersOf10 {
+	static constexpr STD::uint64_t value[20] {
+		1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+		10000000000u, 100000000000u, 1000000000000u, 10000000000000u, 100000000000000u, 1000000000000000u,
+		10000000000000000u, 100000000000000000u, 1000000000000000000u, 10000000000000000000u};
+};
+template <typename T> constexpr STD::uint64_t PowersOf10<T>::value[20];
+
+/**< 10^n for 0 <= n < 20. */
+constexpr STD::uint64_t powerOf10(int n) {return PowersOf10<>::value[n];}
+
+/**< The two decimal digits of each n < 100, at 2*n and 2*n+1. */
+template <typename=void>
+struct DigitPairs {
+	static constexpr unsigned char value[200] {
+		0,0, 0,1, 0,2, 0,3, 0,4, 0,5, 0,6, 0,7, 0,8, 0,9, 1,0, 1,1, 1,2, 1,3, 1,4, 1,5, 1,6, 1,7, 1,8, 1,9,
+		2,0, 2,1, 2,2, 2,3, 2,4, 2,5, 2,6, 2,7, 2,8, 2,9, 3,0, 3,1, 3,2, 3,3, 3,4, 3,5, 3,6, 3,7, 3,8, 3,9,
+		4,0, 4,1, 4,2, 4,3, 4,4, 4,5, 4,6, 4,7, 4,8, 4,9, 5,0, 5,1, 5,2, 5,3, 5,4, 5,5, 5,6, 5,7, 5,8, 5,9,
+		6,0, 6,1, 6,2, 6,3, 6,4, 6,5, 6,6, 6,7, 6,8, 6,9, 7,0, 7,1, 7,2, 7,3, 7,4, 7,5, 7,6, 7,7, 7,8, 7,9,
+		8,0, 8,1, 8,2, 8,3, 8,4, 8,5, 8,6, 8,7, 8,8, 8,9, 9,0, 9,1, 9,2, 9,3, 9,4, 9,5, 9,6, 9,7, 9,8, 9,9};
+};
+template <typename T> constexpr unsigned char DigitPairs<T>::value[200];
+
+/**< Writes the two decimal digits of n < 100, mapped through digits, in front of last. */
+template <typename CharT, typename P>
+constexpr void writeDigitPair( CharT* last, STD::uint32_t n, P digits ) {
+	auto pair = DigitPairs<>::value + 2*n;
+	last[-2] = digits[pair[0]];
+	last[-1] = digits[pair[1]];
+}
+
+/**< Writes the decimal digits of v, mapped through digits, backwards ending in front of last. Returns the first one.
+     Splits off eight digits at a time, so that the rest of the work is on 32-bit values, and these into pairs of
+     digits that don't depend on each other. */
+template <typename CharT, typename P>
+constexpr CharT* writeDecimalBackwards( CharT* last, STD::uint64_t v, P digits ) {
+	for (; v >= 100000000; v /= 100000000, last -= 8) {
+		auto low = static_cast<STD::uint32_t>(v % 100000000),
+		     upper = low / 10000, lower = low % 10000;
+		writeDigitPair(last,     lower % 100, digits);
+		writeDigitPair(last - 2, lower / 100, digits);
+		writeDigitPair(last - 4, upper % 100, digits);
+		writeDigitPair(last - 6, upper / 100, digits);
+	}
+	auto high = static_cast<STD::uint32_t>(v);
+	for (; high >= 100; high /= 100, last -= 2)
+		writeDigitPair(last, high % 100, digits);
+	if (high < 10) {
+		*--last = digits[high];
+		return last;
+	}
+	writeDigitPair(last, high, digits);
+	return last - 2;
+}
+
+/**< The shortest decimal value that rounds to the nonzero b; if there are several, the one closest to b.
+     This is Ulf Adams' Ryu (PLDI 2018), which only needs 64x64-bit multiplications with the tables in RyuTables.
+     The algorithm only depends on the rounding interval around b, so single precision values are handled by the
+     same code. The result has no trailing zeroes. */
+constexpr DecimalFloat shortestDecimal(BinaryFloat const& b) {
+	using tables = RyuTables<>;
+
+	// Work with the interval [mm, mp] around mv = 4*mantissa, scaled by 2^e2.
+	int const e2 = b.exponent - 2;
+	STD::uint64_t const mv = 4*b.mantissa;
+	int const mm_shift = !b.lower_boundary_closer;
+	bool const accept_bounds = b.mantissa % 2 == 0;
+
+	// Compute vr, vp and vm, the decimal significands of mv, mp and mm scaled by 10^-e10, truncated.
+	STD::uint64_t vr = 0, vp = 0, vm = 0;
+	int e10 = 0;
+	bool vm_trailing_zeroes = false, vr_trailing_zeroes = false;
+	if (e2 >= 0) {
+		int const q = log10Pow2(e2) - (e2 > 3),
+		          i = -e2 + q + tables::pow5_inv_bitcount + pow5Bits(q) - 1;
+		auto mul = tables::pow5_inv_split[q];
+		e10 = q;
+		vr = mulShift64(mv, mul, i);
+		vp = mulShift64(mv + 2, mul, i);
+		vm = mulShift64(mv - 1 - mm_shift, mul, i);
+		// Only one of mp, mv and mm can be a multiple of 5, if any; 5^22 exceeds all of them otherwise.
+		if (q <= 21) {
+			if (mv % 5 == 0)
+				vr_trailing_zeroes = multipleOfPowerOf5(mv, q);
+			else if (accept_bounds)
+				vm_trailing_zeroes = multipleOfPowerOf5(mv - 1 - mm_shift, q);
+			else
+				vp -= multipleOfPowerOf5(mv + 2, q);
+		}
+	}
+	else {
+		int const q = log10Pow5(-e2) - (-e2 > 1),
+		          i = -e2 - q,
+		          j = q - (pow5Bits(i) - tables::pow5_bitcount);
+		auto mul = tables::pow5_split[i];
+		e10 = q + e2;
+		vr = mulShift64(mv, mul, j);
+		vp = mulShift64(mv + 2, mul, j);
+		vm = mulShift64(mv - 1 - mm_shift, mul, j);
+		if (q <= 1) {
+			// mv has at least two trailing zero bits, mp = mv + 2 has one, and mm = mv - 1 - mm_shift has one iff mm_shift does.
+			vr_trailing_zeroes = true;
+			if (accept_bounds)
+				vm_trailing_zeroes = mm_shift == 1;
+			else
+				--vp;
+		}
+		else if (q < 63)
+			vr_trailing_zeroes = multipleOfPowerOf2(mv, q);
+	}
+
+	// Remove as many digits as the interval allows, keeping track of the last one for rounding.
+	int removed = 0;
+	int last_removed = 0;
+	STD::uint64_t output = 0;
+	if (vm_trailing_zeroes || vr_trailing_zeroes) {
+		for (; vp / 10 > vm / 10; ++removed) {
+			vm_trailing_zeroes &= vm % 10 == 0;
+			vr_trailing_zeroes &= last_removed == 0;
+			last_removed = vr % 10;
+			vr /= 10; vp /= 10; vm /= 10;
+		}
+		if (vm_trailing_zeroes)
+			for (; vm % 10 == 0; ++removed) {
+				vr_trailing_zeroes &= last_removed == 0;
+				last_removed = vr % 10;
+				vr /= 10; vp /= 10; vm /= 10;
+			}
+		// Round to even if the exact value is ...50...0.
+		if (vr_trailing_zeroes && last_removed == 5 && vr % 2 == 0)
+			last_removed = 4;
+		output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeroes)) || last_removed >= 5);
+	}
+	else {
+		// The common case, in which none of the interval's boundaries is exact.
+		bool round_up = false;
+		if (vp / 100 > vm / 100) {
+			round_up = vr % 100 >= 50;
+			vr /= 100; vp /= 100; vm /= 100;
+			removed += 2;
+		}
+		for (; vp / 10 > vm / 10; ++removed) {
+			round_up = vr % 10 >= 5;
+			vr /= 10; vp /= 10; vm /= 10;
+		}
+		output = vr + (vr == vm || round_up);
+	}
+
+	int exponent = e10 + removed;
+	for (; output % 10 == 0; output /= 10)
+		++exponent;
+	return {output, exponent};
+}
+
+/**< Produces the exact decimal expansion of a BinaryFloat's magnitude digit by digit, starting with its first significant
+     digit. The integral part is converted up front; the fractional part, a binary fraction of at most 1074 bits, yields
+     nine digits each time it's multiplied by 10^9. */
+class ExactDecimalDigits {
+	static constexpr STD::uint32_t _chunk = 1000000000;
+	static constexpr int _chunk_digits = 9;
+	static constexpr int _max_words = 36;
+
+	using _words_type = Array<STD::uint32_t, _max_words>;
+
+	Array<char, 320> _integral {};
+	int _integral_size = 0, _integral_pos = 0, _integral_nonzero_end = 0;
+
+	// Little-endian words of the fraction, whose denominator is 2^(32*_fraction_size).
+	// Words outside [_fraction_low, _fraction_high) are zero.
+	_words_type _fraction {};
+	int _fraction_low = 0, _fraction_high = 0, _fraction_size = 0;
+
+	Array<char, _chunk_digits> _pending {};
+	int _pending_pos = _chunk_digits;
+
+	int _exponent = 0;
+
+	/**< Stores m * 2^shift into words, returning the number of words used. */
+	static constexpr int _place(_words_type& words, STD::uint64_t m, int shift) {
+		int w = shift/32, s = shift%32;
+		words[w]   = static_cast<STD::uint32_t>(m << s);
+		words[w+1] = static_cast<STD::uint32_t>(m >> (32-s));
+		words[w+2] = static_cast<STD::uint32_t>((m >> (32-s)) >> 32);
+		int size = w+3;
+		while (size > 0 && words[size-1] == 0)
+			--size;
+		return size;
+	}
+
+	constexpr void _setIntegral(STD::uint64_t m, int shift) {
+		Array<STD::uint32_t, _max_words> chunks {};
+		int count = 0;
+		if (shift < 64 && (m >> (63-shift)) >> 1 == 0)
+			for (m <<= shift; m != 0; m /= _chunk)
+				chunks[count++] = m % _chunk;
+		else {
+			_words_type words {};
+			for (int size = _place(words, m, shift); size != 0;) {
+				STD::uint64_t rem = 0;
+				for (int i = size; i-- > 0;) {
+					auto cur = (rem << 32) | words[i];
+					words[i] = static_cast<STD::uint32_t>(cur / _chunk);
+					rem = cur % _chunk;
+				}
+				chunks[count++] = static_cast<STD::uint32_t>(rem);
+				while (size > 0 && words[size-1] == 0)
+					--size;
+			}
+		}
+		for (int c = count; c-- > 0;) {
+			auto start = _integral_size;
+			_integral_size += _chunk_digits;
+			for (auto i = _integral_size; i-- > start; chunks[c] /= 10)
+				_integral[i] = chunks[c] % 10;
+		}
+		// Drop the leading zeroes of the most significant chunk.
+		while (_integral_pos != _integral_size && _integral[_integral_pos] == 0)
+			++_integral_pos;
+		_integral_nonzero_end = _integral_size;
+		while (_integral_nonzero_end != _integral_pos && _integral[_integral_nonzero_end-1] == 0)
+			--_integral_nonzero_end;
+	}
+
+	/**< Multiplies the fraction by 10^9 and returns the integral part of the product. */
+	constexpr STD::uint32_t _nextChunk() {
+		STD::uint64_t carry = 0;
+		for (int i = _fraction_low; i != _fraction_high; ++i) {
+			auto t = STD::uint64_t(_fraction[i]) * _chunk + carry;
+			_fraction[i] = static_cast<STD::uint32_t>(t);
+			carry = t >> 32;
+		}
+		if (_fraction_high != _fraction_size) {
+			if (carry != 0)
+				_fraction[_fraction_high++] = static_cast<STD::uint32_t>(carry);
+			carry = 0;
+		}
+		while (_fraction_low != _fraction_high && _fraction[_fraction_low] == 0)
+			++_fraction_low;
+		return static_cast<STD::uint32_t>(carry);
+	}
+
+	constexpr void _fillPending(STD::uint32_t chunk) {
+		for (int i = _chunk_digits; i-- > 0; chunk /= 10)
+			_pending[i] = chunk % 10;
+		_pending_pos = 0;
+	}
+
+public:
+	constexpr explicit ExactDecimalDigits(BinaryFloat const& b) {
+		auto m = b.mantissa;
+		int e = b.exponent;
+		if (m == 0)
+			return;
+
+		if (e >= 0)
+			_setIntegral(m, e);
+		else {
+			int fraction_bits = -e;
+			if (fraction_bits < 64) {
+				_setIntegral(m >> fraction_bits, 0);
+				m &= (STD::uint64_t(1) << fraction_bits) - 1;
+			}
+			auto align = (32 - fraction_bits%32) % 32;
+			_fraction_size = (fraction_bits + align) / 32;
+			_fraction_high = _place(_fraction, m, align);
+			while (_fraction_low != _fraction_high && _fraction[_fraction_low] == 0)
+				++_fraction_low;
+		}
+
+		if (_integral_pos != _integral_size)
+			_exponent = _integral_size - _integral_pos - 1;
+		else {
+			// Skip the fraction's leading zeroes.
+			_exponent = -1;
+			STD::uint32_t chunk = 0;
+			while ((chunk = _nextChunk()) == 0)
+				_exponent -= _chunk_digits;
+			_fillPending(chunk);
+			for (; _pending[_pending_pos] == 0; ++_pending_pos)
+				--_exponent;
+		}
+	}
+
+	/**< The decimal exponent of the first significant digit. */
+	constexpr int exponent() const {return _exponent;}
+
+	/**< Returns the next digit, which is zero once the expansion is exhausted. */
+	constexpr int next() {
+		if (_integral_pos != _integral_size)
+			return _integral[_integral_pos++];
+		if (_pending_pos == _chunk_digits)
+			_fillPending(_nextChunk());
+		return _pending[_pending_pos++];
+	}
+
+	/**< Whether all remaining digits are zero. */
+	constexpr bool exhausted() const {
+		if (_integral_pos < _integral_nonzero_end)
+			return false;
+		for (auto i = _pending_pos; i != _chunk_digits; ++i)
+			if (_pending[i] != 0)
+				return false;
+		return _fraction_low == _fraction_high;
+	}
+};
+
+/**< Computes floor(|b| * 10^scale) for 0 <= scale < 20 and a negative exponent of b with one 64x64-bit multiplication,
+     and sets round_up to whether rounding it to nearest with ties to even increments it. Returns false if the result
+     doesn't fit into 64 bits. */
+constexpr bool scaleExactly(BinaryFloat const& b, int scale, STD::uint64_t& floor, bool& round_up) {
+	STD::uint64_t high = 0;
+	auto low = umul128(b.mantissa, powerOf10(scale), high);
+	int shift = -b.exponent;
+	// The fraction shifted out is compared with one half through its leading 64 bits, and whether any below are set.
+	STD::uint64_t fraction = 0, half = 0;
+	bool below = false;
+	if (shift < 64) {
+		if (high >> shift != 0)
+			return false;
+		floor = (low >> shift) | (high << (64 - shift));
+		fraction = low & ((STD::uint64_t(1) << shift) - 1);
+		half = STD::uint64_t(1) << (shift - 1);
+	}
+	else if (shift < 128) {
+		shift -= 64;
+		floor = high >> shift;
+		fraction = shift == 0? low : high & ((STD::uint64_t(1) << shift) - 1);
+		half = STD::uint64_t(1) << (shift == 0? 63 : shift - 1);
+		below = shift != 0 && low != 0;
+	}
+	else {
+		// The product is below 2^117, i.e. less than half of the last position.
+		floor = 0;
+		round_up = false;
+		return true;
+	}
+	round_up = fraction > half || (fraction == half && (below || floor % 2 != 0));
+	return true;
+}
+
+/**< writeRoundedDigits for nonzero b, based on b's shortest representation.
+     Its digits determine the result whenever there are more of them than needed (and the dropped ones aren't
+     exactly 5); if there are fewer and the value's precision guarantees they're exact, they're padded with
+     zeroes. Only otherwise the exact expansion is generated. */
+template <typename CharT, typename P>
+constexpr int writeRoundedShortestDigits( CharT* out, int capacity, BinaryFloat const& b, int precision, bool fixed, P digits, int& first ) {
+	auto d = shortestDecimal(b);
+	CharT shortest[20] {};
+	auto const shortest_first = writeDecimalBackwards(shortest + 20, d.digits, digits);
+	int length = shortest + 20 - shortest_first,
+	    count = fixed? d.exponent + length + precision : precision + 1;
+	first = d.exponent + length - 1;
+	// The exact expansion's first digit is never above the shortest one's, so count doesn't grow below.
+	int needed = count > precision + 1? count : precision + 1;
+	if (needed > capacity)
+		return -needed;
+	// Values of at most this many digits are exactly represented by d.
+	int const exact_digits = (b.precision-1) * 30103 / 100000;
+	bool round_up = false;
+	int size = 0;
+
+	// If count is negative, |b| is below half of the last position and rounds to zero.
+	if (count >= 0) {
+		if (length > count + 1 || (length == count + 1 && shortest_first[count] != digits[5])) {
+			// The dropped digits exceed half of the last position if the first is above 5, or is 5 with more to follow.
+			round_up = shortest_first[count] > digits[5];
+			for (int i = count + 1; i < length && !round_up && shortest_first[count] == digits[5]; ++i)
+				round_up = shortest_first[i] != digits[0];
+			for (; size != count; ++size)
+				out[size] = shortest_first[size];
+		}
+		else if (length <= count && count <= exact_digits && b.normal()) {
+			for (; size != length; ++size)
+				out[size] = shortest_first[size];
+			for (; size != count; ++size)
+				out[size] = digits[0];
+		}
+		else {
+			ExactDecimalDigits expansion(b);
+			first = expansion.exponent();
+			count = fixed? first + 1 + precision : precision + 1;
+			if (count >= 0) {
+				int last = 0;
+				for (; size != count; ++size)
+					out[size] = digits[last = expansion.next()];
+				int next = expansion.next();
+				round_up = next > 5 || (next == 5 && (last % 2 != 0 || !expansion.exhausted()));
+			}
+		}
+	}
+
+	if (round_up) {
+		auto i = size;
+		while (i != 0 && out[i-1] == digits[9])
+			out[--i] = digits[0];
+		if (i != 0)
+			++out[i-1];
+		else {
+			// All digits were nines and are now zeroes: the result is a one followed by them.
+			if (fixed) {
+				if (size == capacity)
+					return -(size + 1);
+				out[size++] = digits[0];
+			}
+			out[0] = digits[1];
+			++first;
+		}
+	}
+	if (fixed && size < precision + 1) {
+		auto pad = precision + 1 - size;
+		for (auto i = size; i-- > 0;)
+			out[i + pad] = out[i];
+		for (int i = 0; i != pad; ++i)
+			out[i] = digits[0];
+		size = precision + 1;
+	}
+	return size;
+}
+
+/**< Writes the digits of |b| that precede the decimal position 10^(first-count) to out, rounded to nearest with ties
+     to even, where first is the exponent of b's first significant digit and count is determined from it by
+     fixed ? first+1+precision : precision+1. The digit values are mapped through digits, which must be consecutive.
+     Stores in first the exponent of the first digit written, which rounding may have incremented. If fixed, the
+     digits of round(|b| * 10^precision) are written instead, padded with leading zeroes to at least precision+1 of them.
+     Returns the number of digits written, or, if capacity doesn't suffice, the negated capacity needed. That is
+     the number of digits, or one more if rounding carries into a new leading digit in fixed notation.
+     Normal values below 2^52 (2^23 for single precision) whose result fits into 64 bits are scaled exactly by
+     scaleExactly, others are left to writeRoundedShortestDigits. */
+template <typename CharT, typename P>
+constexpr int writeRoundedDigits( CharT* out, int capacity, BinaryFloat const& b, int precision, bool fixed, P digits, int& first ) {
+	first = 0;
+	if (b.mantissa == 0) {
+		if (capacity < precision + 1)
+			return -(precision + 1);
+		for (int i = 0; i != precision + 1; ++i)
+			out[i] = digits[0];
+		return precision + 1;
+	}
+
+	if (b.exponent < 0 && b.normal() && precision < 19) {
+		STD::uint64_t scaled = 0;
+		bool round_up = false;
+		int scale = precision;
+		if (!fixed) {
+			// The first digit's exponent is floor(log10(2^e)) for |b| in [2^e, 2^(e+1)), or one more.
+			int e = b.exponent + b.precision - 1;
+			first = e >= 0? log10Pow2(e) : -log10Pow2(-e) - 1;
+			scale = precision - first;
+		}
+		bool exact = 0 <= scale && scale < 20 && scaleExactly(b, scale, scaled, round_up) && scaled < powerOf10(19);
+		if (exact && !fixed && scaled >= powerOf10(precision + 1)) {
+			// One digit too many: the exponent is the larger one.
+			++first;
+			exact = scale-- != 0 && scaleExactly(b, scale, scaled, round_up);
+		}
+		if (exact) {
+			scaled += round_up;
+			if (!fixed && scaled == powerOf10(precision + 1)) {
+				scaled /= 10;
+				++first;
+			}
+			CharT buffer[20] {};
+			auto const scaled_first = writeDecimalBackwards(buffer + 20, scaled, digits);
+			int length = buffer + 20 - scaled_first,
+			    size = length > precision + 1? length : precision + 1;
+			if (fixed)
+				first = length - 1 - precision;
+			if (size > capacity)
+				return -size;
+			for (int i = 0; i != size - length; ++i)
+				out[i] = digits[0];
+			for (int i = 0; i != length; ++i)
+				out[size - length + i] = scaled_first[i];
+			return size;
+		}
+	}
+
+	return writeRoundedShortestDigits(out, capacity, b, precision, fixed, digits, first);
+}
+
+}}
@@ -0,0 +1,294 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "../Math.hxx"
+#include "FloatDecimal.hxx"
+#include "LemireTables.hxx"
+
+namespace Constainer { namespace detail {
+
+/**< The parameters of decimalToBinary for a format with the given number of significant bits. */
+template <int Digits>
+struct DecimalToBinaryFormat;
+
+template <>
+struct DecimalToBinaryFormat<53> {
+	static constexpr int explicit_bits = 52,
+	                     minimum_exponent = -1023,
+	                     infinite_power = 0x7FF,
+	                     smallest_power_of_ten = -342,
+	                     largest_power_of_ten = 308,
+	                     min_exponent_round_to_even = -4,
+	                     max_exponent_round_to_even = 23,
+	                     max_digits = 769; // Digits beyond never decide the rounding, except for being nonzero
+};
+
+template <>
+struct DecimalToBinaryFormat<24> {
+	static constexpr int explicit_bits = 23,
+	                     minimum_exponent = -127,
+	                     infinite_power = 0xFF,
+	                     smallest_power_of_ten = -65,
+	                     largest_power_of_ten = 38,
+	                     min_exponent_round_to_even = -17,
+	                     max_exponent_round_to_even = 10,
+	                     max_digits = 114;
+};
+
+/**< The fraction bits and the biased exponent of a binary floating-point value, as they appear in its representation. */
+struct AdjustedMantissa {
+	STD::uint64_t mantissa = 0;
+	int biased_exponent = 0;
+};
+
+constexpr bool operator==(AdjustedMantissa const& lhs, AdjustedMantissa const& rhs) {
+	return lhs.mantissa == rhs.mantissa && lhs.biased_exponent == rhs.biased_exponent;
+}
+constexpr bool operator!=(AdjustedMantissa const& lhs, AdjustedMantissa const& rhs) {return !(lhs == rhs);}
+
+/**< w * 10^q rounded to nearest with ties to even, by Eisel and Lemire's algorithm as described in "Number Parsing at a
+     Gigabyte per Second" (Daniel Lemire, 2021). Results beyond the range of Float have the biased exponent
+     infinite_power. */
+template <typename Float>
+constexpr AdjustedMantissa eiselLemire(STD::int64_t q, STD::uint64_t w) {
+	using format = DecimalToBinaryFormat<STD::numeric_limits<Float>::digits>;
+	using tables = LemireTables<>;
+
+	if (w == 0 || q < format::smallest_power_of_ten)
+		return {0, 0};
+	if (q > format::largest_power_of_ten)
+		return {0, format::infinite_power};
+
+	int const lz = count_leading(w);
+	w <<= lz;
+
+	// The product of w with the truncated 5^q; the second half of the table entry only matters if the bits below the
+	// ones we keep are all set, as adding to them might then carry into the latter.
+	auto const* power = tables::pow5_128[q - tables::smallest_power_of_five];
+	STD::uint64_t high = 0,
+	              low = umul128(w, power[1], high);
+	constexpr auto precision_mask = ~STD::uint64_t(0) >> (format::explicit_bits + 3);
+	if ((high & precision_mask) == precision_mask) {
+		STD::uint64_t second_high = 0;
+		umul128(w, power[0], second_high);
+		low += second_high;
+		if (second_high > low)
+			++high;
+	}
+
+	int const upperbit = static_cast<int>(high >> 63),
+	          shift = upperbit + 64 - format::explicit_bits - 3;
+	AdjustedMantissa am {high >> shift,
+	                     static_cast<int>(((217706 * q) >> 16) + 63 + upperbit - lz - format::minimum_exponent)};
+
+	if (am.biased_exponent <= 0) { // Subnormal
+		if (-am.biased_exponent + 1 >= 64)
+			return {0, 0};
+		am.mantissa >>= -am.biased_exponent + 1;
+		am.mantissa += am.mantissa & 1;
+		am.mantissa >>= 1;
+		// Rounding up might have produced the smallest normal value
+		am.biased_exponent = am.mantissa < (STD::uint64_t(1) << format::explicit_bits)? 0 : 1;
+		return am;
+	}
+
+	// Exact halfway cases, which only exist for small q, round to even rather than up
+	if (low <= 1 && q >= format::min_exponent_round_to_even && q <= format::max_exponent_round_to_even
+	 && (am.mantissa & 3) == 1 && (am.mantissa << shift) == high)
+		am.mantissa &= ~STD::uint64_t(1);
+
+	am.mantissa += am.mantissa & 1;
+	am.mantissa >>= 1;
+	if (am.mantissa >= (STD::uint64_t(2) << format::explicit_bits)) {
+		am.mantissa = STD::uint64_t(1) << format::explicit_bits;
+		++am.biased_exponent;
+	}
+	am.mantissa &= ~(STD::uint64_t(1) << format::explicit_bits);
+
+	if (am.biased_exponent >= format::infinite_power)
+		return {0, format::infinite_power};
+	return am;
+}
+
+/**< A nonnegative integer of up to 3200 bits, which suffices for the comparisons in roundDecimal. */
+class BigUInt {
+	static constexpr int _max_words = 100;
+	Array<STD::uint32_t, _max_words> _words {};
+	int _size = 0;
+
+public:
+
+	constexpr explicit BigUInt(STD::uint64_t v = 0) {
+		for (; v != 0; v >>= 32)
+			_words[_size++] = static_cast<STD::uint32_t>(v);
+	}
+
+	/**< *this = *this * factor + summand. */
+	constexpr void multiplyAdd(STD::uint32_t factor, STD::uint32_t summand) {
+		STD::uint64_t carry = summand;
+		for (int i = 0; i < _size; ++i) {
+			carry += STD::uint64_t(_words[i]) * factor;
+			_words[i] = static_cast<STD::uint32_t>(carry);
+			carry >>= 32;
+		}
+		if (carry != 0)
+			_words[_size++] = static_cast<STD::uint32_t>(carry);
+	}
+
+	constexpr void multiplyByPowerOf5(int n) {
+		for (; n >= 13; n -= 13)
+			multiplyAdd(1220703125, 0); // 5^13
+		STD::uint32_t factor = 1;
+		while (n-- > 0)
+			factor *= 5;
+		multiplyAdd(factor, 0);
+	}
+
+	constexpr void shiftLeft(int n) {
+		if (_size == 0)
+			return;
+		int const words = n / 32,
+		          bits  = n % 32;
+		if (bits != 0) {
+			STD::uint32_t carry = 0;
+			for (int i = 0; i < _size; ++i) {
+				auto w = _words[i];
+				_words[i] = (w << bits) | carry;
+				carry = w >> (32 - bits);
+			}
+			if (carry != 0)
+				_words[_size++] = carry;
+		}
+		if (words != 0) {
+			for (int i = _size; i-- > 0;)
+				_words[i + words] = _words[i];
+			for (int i = 0; i < words; ++i)
+				_words[i] = 0;
+			_size += words;
+		}
+	}
+
+	/**< Returns a negative value, zero or a positive value if lhs is less than, equal to or greater than rhs. */
+	friend constexpr int compare(BigUInt const& lhs, BigUInt const& rhs) {
+		if (lhs._size != rhs._size)
+			return lhs._size < rhs._size? -1 : 1;
+		for (int i = lhs._size; i-- > 0;)
+			if (lhs._words[i] != rhs._words[i])
+				return lhs._words[i] < rhs._words[i]? -1 : 1;
+		return 0;
+	}
+};
+
+/**< Decides whether the decimal value given by the count significant digits starting at first, ignoring a decimal
+     point in between, times 10^exponent rounds to b or to its successor, by comparing it exactly with their midpoint.
+     This is required if eiselLemire could only use a prefix of the digits, and the remainder affects the result. */
+template <typename Float, typename InputIt>
+constexpr AdjustedMantissa roundDecimal(AdjustedMantissa b, InputIt first, int count, STD::int64_t exponent) {
+	using format = DecimalToBinaryFormat<STD::numeric_limits<Float>::digits>;
+
+	BigUInt value;
+	int used = count;
+	if (used > format::max_digits)
+		used = format::max_digits;
+	STD::uint32_t chunk = 0;
+	int chunk_digits = 0;
+	for (int i = 0; i < used; ++first) {
+		if (*first == '.')
+			continue;
+		chunk = chunk*10 + static_cast<STD::uint32_t>(*first - '0');
+		++i;
+		if (++chunk_digits == 9) {
+			value.multiplyAdd(1000000000, chunk);
+			chunk = chunk_digits = 0;
+		}
+	}
+	value.multiplyAdd(static_cast<STD::uint32_t>(powerOf10(chunk_digits)), chunk);
+	exponent += count - used;
+	// The omitted digits can only matter through being nonzero, which an appended 1 accounts for
+	bool nonzero = false;
+	for (int i = used; i < count && !nonzero; ++first)
+		if (*first != '.') {
+			nonzero = *first != '0';
+			++i;
+		}
+	if (nonzero) {
+		value.multiplyAdd(10, 1);
+		--exponent;
+	}
+
+	// The midpoint is (2*m + 1) * 2^(k-1), for the significand m and the exponent k of b
+	constexpr auto hidden_bit = STD::uint64_t(1) << format::explicit_bits;
+	bool const subnormal = b.biased_exponent == 0;
+	int const k = (subnormal? 1 : b.biased_exponent) + format::minimum_exponent - format::explicit_bits;
+	BigUInt halfway(2*(subnormal? b.mantissa : b.mantissa | hidden_bit) + 1);
+
+	// value * 2^value_shift is compared with halfway * 2^halfway_shift
+	STD::int64_t value_shift = 0, halfway_shift = k - 1;
+	if (exponent >= 0) {
+		value.multiplyByPowerOf5(static_cast<int>(exponent));
+		value_shift = exponent;
+	}
+	else {
+		halfway.multiplyByPowerOf5(static_cast<int>(-exponent));
+		halfway_shift -= exponent;
+	}
+	auto const common = value_shift < halfway_shift? value_shift : halfway_shift;
+	value.shiftLeft(static_cast<int>(value_shift - common));
+	halfway.shiftLeft(static_cast<int>(halfway_shift - common));
+
+	int const order = compare(value, halfway);
+	if (order > 0 || (order == 0 && (b.mantissa & 1) != 0)) {
+		// The successor, which might be the next binade or infinity
+		if (++b.mantissa == hidden_bit) {
+			b.mantissa = 0;
+			++b.biased_exponent;
+		}
+	}
+	return b;
+}
+
+/**< The Float nearest to a decimal value with count significant digits, the first of which is at significant. w holds
+     the first 19 of them, scaled by 10^q, and truncated indicates that the remaining ones are not all zero. */
+template <typename Float, typename InputIt>
+constexpr AdjustedMantissa decimalToBinary( STD::uint64_t w, STD::int64_t q, bool truncated,
+                                            InputIt significant, int count ) {
+	auto am = eiselLemire<Float>(q, w);
+	// The value lies in [w, w+1) * 10^q; if both ends round alike, so does the value
+	if (truncated && am != eiselLemire<Float>(q, w+1))
+		am = roundDecimal<Float>(am, significant, count, q - (count - 19));
+	return am;
+}
+
+/**< The value with the representation given by am and negative. Without bit_cast, it is computed arithmetically by
+     scaling with powers of two, which is exact. */
+template <typename Float>
+constexpr Float composeFloat(AdjustedMantissa am, bool negative) {
+	static_assert(isDecimalFormattable<Float>{}, "Only IEEE single and double precision values can be composed");
+	using format = DecimalToBinaryFormat<STD::numeric_limits<Float>::digits>;
+#ifdef CONSTAINER_HAS_BIT_CAST
+	using bits_type = STD::conditional_t<sizeof(Float) == 4, STD::uint32_t, STD::uint64_t>;
+	constexpr int bits = sizeof(Float)*CHAR_BIT;
+	return bit_cast<Float>(static_cast<bits_type>(am.mantissa
+	                                            | STD::uint64_t(am.biased_exponent) << format::explicit_bits
+	                                            | STD::uint64_t(negative) << (bits-1)));
+#else
+	if (am.biased_exponent == format::infinite_power)
+		return negative? -STD::numeric_limits<Float>::infinity() : STD::numeric_limits<Float>::infinity();
+
+	int e = (am.biased_exponent == 0? 1 : am.biased_exponent) + format::minimum_exponent - format::explicit_bits;
+	if (am.biased_exponent != 0)
+		am.mantissa |= STD::uint64_t(1) << format::explicit_bits;
+	Float v = static_cast<Float>(am.mantissa);
+	Float const step = 18446744073709551616.0; // 2^64
+	for (; e >= 64;  e -= 64) v *= step;
+	for (; e <= -64; e += 64) v /= step;
+	for (; e > 0; --e) v *= 2;
+	for (; e < 0; ++e) v /= 2;
+	return negative? -v : v;
+#endif
+}
+
+}}
@@ -37,6 +37,26 @@
 	#endif
 #endif // defined CONSTAINER_PURE_CONST
 
+#ifndef CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+	#if defined __has_builtin
+		#if __has_builtin(__builtin_is_constant_evaluated)
+			#define CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+		#endif
+	#elif defined __GNUC__ && __GNUC__ >= 9
+		#define CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+	#endif
+#endif // defined CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+
+#ifndef CONSTAINER_HAS_BIT_CAST
+	#if defined __has_builtin
+		#if __has_builtin(__builtin_bit_cast)
+			#define CONSTAINER_HAS_BIT_CAST
+		#endif
+	#elif defined __GNUC__ && __GNUC__ >= 11
+		#define CONSTAINER_HAS_BIT_CAST
+	#endif
+#endif // defined CONSTAINER_HAS_BIT_CAST
+
 #define CONSTAINER_DIAGNOSTIC_PUSH _Pragma("GCC diagnostic push")
 #define CONSTAINER_DIAGNOSTIC_POP  _Pragma("GCC diagnostic pop")
 #define CONSTAINER_STRINGIZE_(x) #x
@@ -93,6 +113,26 @@ constexpr auto addressof( T& t ) {
 template <typename T>
 constexpr decltype(auto) as_const(T const& obj) {return obj;}
 
+/**< Whether the call is evaluated as part of a constant expression. Guards runtime-only fast paths, such as
+     memcpy, behind which the constexpr implementation remains as fallback. Without compiler support, this
+     always yields true, i.e. the fast paths are never taken. */
+constexpr bool isConstantEvaluated() {
+#ifdef CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+#ifdef CONSTAINER_HAS_BIT_CAST
+/**< Reinterprets the object representation of from as a To, also in constant expressions (cf. C++20's bit_cast). */
+template <typename To, typename From>
+constexpr To bit_cast(From const& from) {
+	static_assert(sizeof(To) == sizeof(From), "bit_cast requires types of equal size");
+	return __builtin_bit_cast(To, from);
+}
+#endif
+
 template <typename...>
 using void_t = void;
 
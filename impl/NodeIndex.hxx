@@ -0,0 +1,389 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "../Algorithms.hxx"
+#include "../ChunkPool.hxx"
+#include "../Operators.hxx"
+#include "../Vector.hxx"
+
+namespace Constainer { namespace detail {
+
+/**< Indices map the positions of a BasicStableVector to its nodes, and nodes back to their positions.
+     Each node has a member link of type Index::Link, through which the index finds the node's slot.
+     A slot_iterator is a random access iterator over the slots, dereferencing to Node*&.
+     All indices keep an end sentinel node in the slot after the last element. */
+
+/**< A flat array of node pointers, each node pointing back at its slot. Positions are resolved in O(1),
+     but inserting or erasing rewrites the back-pointers of all following nodes. */
+template <typename Node, STD::size_t MaxN>
+class FlatNodeIndex {
+public:
+	using size_type       = STD::size_t;
+	using difference_type = STD::ptrdiff_t;
+	using slot_iterator   = Node**;
+
+	struct Link {slot_iterator up = nullptr;};
+
+private:
+	Vector<Node*, MaxN+1> _pointers;
+
+public:
+	constexpr explicit FlatNodeIndex(Node* end) : _pointers{end} {
+		link(_pointers.begin());
+	}
+
+	constexpr size_type size() const {return _pointers.size()-1;}
+	constexpr Node* at(size_type pos) const {return _pointers[pos];}
+
+	static constexpr slot_iterator slot_of(Node const* n) {return n->link.up;}
+	static constexpr void link(slot_iterator s) {(*s)->link.up = s;}
+
+	static constexpr Node* advance(Node const* n, difference_type d) {return n->link.up[d];}
+	static constexpr difference_type distance(Node const* from, Node const* to) {
+		return to->link.up - from->link.up;
+	}
+
+	/**< Makes room for n nodes in front of pos. Returns the first of the new slots, which are unlinked. */
+	constexpr slot_iterator open(slot_iterator pos, size_type n) {
+		auto i = _pointers.end();
+		countStat(&Stats::moves, i-pos);
+		_pointers.resize(_pointers.size() + n);
+		while (i != pos) {
+			--i;
+			i[n] = *i;
+			link(i+n);
+		}
+		return pos;
+	}
+
+	/**< Removes the slots [first, last), whose nodes must have been released already. */
+	constexpr void close(slot_iterator first, slot_iterator last) {
+		_pointers.erase(first, last);
+		for (; first != _pointers.end(); ++first)
+			link(first);
+	}
+
+	constexpr void clear() {
+		_pointers.erase(_pointers.begin(), _pointers.end()-1);
+		link(_pointers.begin());
+	}
+};
+
+/**< Splits the node pointers into blocks of at most block_size slots. Nodes point to their block and
+     their index in it; every block knows its starting position and its entry in the block order. An insertion
+     or erasure thus rewrites the back-pointers of one block and the start of all following blocks, which is
+     O(sqrt(N)) with the chosen block size. Resolving a position is a binary search over the block starts.
+     Every block but a sole one holds at least block_size/2 nodes, so there are at most 2*MaxN/block_size+1 of them,
+     and the blocks take about twice the memory of a flat array of node pointers. */
+template <typename Node, STD::size_t MaxN>
+class SegmentedNodeIndex {
+public:
+	using size_type       = STD::size_t;
+	using difference_type = STD::ptrdiff_t;
+
+private:
+	CONSTAINER_PURE_CONST static constexpr size_type _block_size() {
+		size_type b = 8;
+		while (b*b < 4*MaxN)
+			b *= 2;
+		return b;
+	}
+
+public:
+	static constexpr size_type block_size = _block_size();
+
+	struct Block {
+		Array<Node*, block_size> nodes {};
+		size_type size = 0;
+		size_type start = 0;
+		Block** up = nullptr;
+		SegmentedNodeIndex const* owner = nullptr;
+	};
+
+	struct Link {
+		Block* block = nullptr;
+		size_type index = 0;
+	};
+
+	class slot_iterator : public RandomAccessIteratable<slot_iterator, Node**, Node*&, difference_type> {
+		Block* _block = nullptr;
+		size_type _index = 0;
+
+		friend SegmentedNodeIndex;
+
+	public:
+		using difference_type   = STD::ptrdiff_t;
+		using value_type        = Node*;
+		using pointer           = Node**;
+		using reference         = Node*&;
+		using iterator_category = STD::random_access_iterator_tag;
+
+		constexpr slot_iterator() = default;
+		constexpr slot_iterator(Block* b, size_type i) : _block(b), _index(i) {}
+
+		constexpr size_type position() const {return _block->start + _index;}
+
+		constexpr reference operator*() const {return _block->nodes[_index];}
+
+		constexpr slot_iterator& operator++() {
+			if (++_index == _block->size) {
+				_block = _block->up[1];
+				_index = 0;
+			}
+			return *this;
+		}
+		constexpr slot_iterator& operator--() {
+			if (_index-- == 0) {
+				_block = _block->up[-1];
+				_index = _block->size-1;
+			}
+			return *this;
+		}
+
+		constexpr slot_iterator& operator+=(difference_type d) {
+			if (d >= -static_cast<difference_type>(_index) && _index + d < _block->size)
+				_index += d;
+			else
+				*this = _block->owner->_locate(position() + d);
+			return *this;
+		}
+		constexpr slot_iterator& operator-=(difference_type d) {return *this += -d;}
+
+		constexpr difference_type operator-(slot_iterator rhs) const {return position() - rhs.position();}
+
+		constexpr bool operator==(slot_iterator rhs) const {return _block == rhs._block && _index == rhs._index;}
+		constexpr bool operator <(slot_iterator rhs) const {return position() < rhs.position();}
+	};
+
+private:
+	static constexpr size_type _max_blocks = 2*MaxN/block_size + 1;
+
+	ChunkPool<Block, _max_blocks> _blocks;
+	Block _end_block;
+	Vector<Block*, _max_blocks+1> _order;
+
+	struct _starts_before {
+		constexpr bool operator()(size_type pos, Block const* b) const {return pos < b->start;}
+	};
+
+	constexpr slot_iterator _locate(size_type pos) const {
+		auto b = Constainer::upper_bound(_order.begin(), _order.end(), pos, _starts_before{})[-1];
+		return {b, pos - b->start};
+	}
+
+	constexpr void _relink_blocks(Block** first) {
+		for (; first != _order.end(); ++first)
+			(*first)->up = first;
+	}
+	constexpr void _shift_starts(Block** first, difference_type d) {
+		countStat(&Stats::moves, _order.end()-first);
+		for (; first != _order.end(); ++first)
+			(*first)->start += d;
+	}
+
+	/**< Inserts n new, empty blocks into the order in front of pos. */
+	constexpr void _new_blocks(Block** pos, size_type n) {
+		_order.insert(pos, n, nullptr);
+		for (auto i = pos; i != pos+n; ++i) {
+			*i = _blocks.grab();
+			**i = Block{};
+			(*i)->owner = this;
+		}
+		_relink_blocks(pos);
+	}
+	constexpr void _remove_block(Block* b) {
+		_blocks.free(b);
+		_relink_blocks(_order.erase(b->up));
+	}
+
+	/**< Appends the nodes of the block following a to a, and removes the former. */
+	constexpr void _merge_next(Block* a) {
+		auto b = a->up[1];
+		for (size_type i = 0; i != b->size; ++i) {
+			a->nodes[a->size] = b->nodes[i];
+			link({a, a->size++});
+		}
+		_remove_block(b);
+	}
+
+	/**< Moves nodes between a and the block following it, which hold more than block_size nodes together,
+	     such that each holds half of them. */
+	constexpr void _balance(Block* a) {
+		auto b = a->up[1];
+		auto a_size = (a->size + b->size) / 2;
+		if (a->size < a_size) {
+			auto k = a_size - a->size;
+			countStat(&Stats::moves, b->size);
+			for (size_type i = 0; i != k; ++i) {
+				a->nodes[a->size] = b->nodes[i];
+				link({a, a->size++});
+			}
+			for (auto i = k; i != b->size; ++i) {
+				b->nodes[i-k] = b->nodes[i];
+				link({b, i-k});
+			}
+			b->size -= k;
+			b->start += k;
+		}
+		else {
+			auto k = a->size - a_size;
+			countStat(&Stats::moves, b->size + k);
+			for (auto i = b->size; i-- > 0;) {
+				b->nodes[i+k] = b->nodes[i];
+				link({b, i+k});
+			}
+			for (size_type i = 0; i != k; ++i) {
+				b->nodes[i] = a->nodes[a_size+i];
+				link({b, i});
+			}
+			a->size = a_size;
+			b->size += k;
+			b->start -= k;
+		}
+	}
+
+	/**< Restores that each block holds at least block_size/2 nodes, unless it is the only one, for the order
+	     range [first, last], which must contain all blocks that shrank. A block below that is merged with its
+	     successor (or predecessor, if it is the last block) if they fit into one block, and balanced with it
+	     otherwise. */
+	constexpr void _rebalance(size_type first, size_type last) {
+		for (auto i = first; i <= last && i+1 < _order.size() && _order.size() > 2;) {
+			if (_order[i]->size >= block_size/2) {
+				++i;
+				continue;
+			}
+			if (i+2 == _order.size())
+				--i;
+			auto a = _order[i];
+			if (a->size + a->up[1]->size <= block_size) {
+				// The merged block is checked again
+				_merge_next(a);
+				if (last != 0)
+					--last;
+			}
+			else {
+				_balance(a);
+				i += 2;
+			}
+		}
+	}
+
+public:
+	constexpr explicit SegmentedNodeIndex(Node* end) : _blocks{}, _end_block{}, _order{&_end_block} {
+		_end_block.nodes[0] = end;
+		_end_block.size = 1;
+		_end_block.owner = this;
+		_relink_blocks(_order.begin());
+		link({&_end_block, 0});
+	}
+
+	constexpr size_type size() const {return _end_block.start;}
+	constexpr Node* at(size_type pos) const {return *_locate(pos);}
+
+	static constexpr slot_iterator slot_of(Node const* n) {return {n->link.block, n->link.index};}
+	static constexpr void link(slot_iterator s) {(*s)->link = {s._block, s._index};}
+
+	static constexpr Node* advance(Node const* n, difference_type d) {return *(slot_of(n) += d);}
+	static constexpr difference_type distance(Node const* from, Node const* to) {
+		return slot_of(to) - slot_of(from);
+	}
+
+	/**< Makes room for n nodes in front of pos. Returns the first of the new slots, which are unlinked. */
+	constexpr slot_iterator open(slot_iterator pos, size_type n) {
+		if (n == 0)
+			return pos;
+		auto x = pos._block;
+		auto l = pos._index;
+		if (x == &_end_block) {
+			if (_order.size() == 1)
+				_new_blocks(_order.begin(), 1);
+			x = _end_block.up[-1];
+			l = x->size;
+		}
+
+		if (x->size + n <= block_size) {
+			countStat(&Stats::moves, x->size-l);
+			for (auto i = x->size; i-- > l;) {
+				x->nodes[i+n] = x->nodes[i];
+				link({x, i+n});
+			}
+			x->size += n;
+			_shift_starts(x->up+1, n);
+			return {x, l};
+		}
+
+		// Distribute the nodes of x together with the new slots evenly over x and enough new blocks, such
+		// that each of them is more than half full. Nodes only move to later slots, so go backwards.
+		auto total = x->size + n,
+		     count = (total + block_size-1) / block_size;
+		_new_blocks(x->up+1, count-1);
+		_shift_starts(x->up+count, n);
+		for (size_type j = 0; j != count; ++j)
+			x->up[j]->size = total/count + (j < total%count);
+		for (auto i = x->up+1; i != x->up+count; ++i)
+			(*i)->start = i[-1]->start + i[-1]->size;
+
+		slot_iterator first_new;
+		auto target = x->up+count-1;
+		for (auto k = total, index = (*target)->size; k-- > STD::min(l, x->size);) {
+			if (index == 0)
+				index = (*--target)->size;
+			--index;
+			if (k < l || k >= l+n) {
+				countStat(&Stats::moves);
+				(*target)->nodes[index] = x->nodes[k < l? k : k-n];
+				link({*target, index});
+			}
+			else if (k == l)
+				first_new = {*target, index};
+		}
+		return first_new;
+	}
+
+	/**< Removes the slots [first, last), whose nodes must have been released already. */
+	constexpr void close(slot_iterator first, slot_iterator last) {
+		auto n = last - first;
+		if (n == 0)
+			return;
+		auto f = first._block, l = last._block;
+		size_type order_pos = f->up - _order.begin();
+		if (f == l) {
+			for (auto i = last._index; i != l->size; ++i) {
+				l->nodes[i-n] = l->nodes[i];
+				link({l, i-n});
+			}
+			l->size -= n;
+			_shift_starts(l->up+1, -n);
+			if (l->size == 0)
+				_remove_block(l);
+		}
+		else {
+			for (auto i = f->up+1; i != l->up; ++i)
+				_blocks.free(*i);
+			_relink_blocks(_order.erase(f->up+1, l->up));
+			for (auto i = last._index; i != l->size; ++i) {
+				l->nodes[i-last._index] = l->nodes[i];
+				link({l, i-last._index});
+			}
+			l->size -= last._index;
+			l->start = f->start + first._index;
+			_shift_starts(l->up+1, -n);
+			f->size = first._index;
+			if (f->size == 0)
+				_remove_block(f);
+		}
+		_rebalance(order_pos == 0? 0 : order_pos-1, order_pos+2);
+	}
+
+	constexpr void clear() {
+		_blocks.free();
+		_order.erase(_order.begin(), _order.end()-1);
+		_end_block.start = 0;
+		_relink_blocks(_order.begin());
+	}
+};
+
+}}
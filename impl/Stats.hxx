@@ -0,0 +1,45 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Fundamental.hxx"
+
+#include <cstdint>
+
+namespace Constainer {
+
+/**< Counts of the work done in the containers' hot paths. They are only maintained if CONSTAINER_STATS is defined
+     before any header of this library is included, and never during constant evaluation (nor at all without
+     support for isConstantEvaluated). Meant for benchmarks, so not thread-safe. */
+struct Stats {
+	STD::uint64_t moves = 0;       /**< Elements shifted to open or close a gap, and index slots or blocks relocated */
+	STD::uint64_t comparisons = 0; /**< Key comparisons in the binary searches of the flat trees */
+	STD::uint64_t probes = 0;      /**< Words of a ChunkPool's usage bitmap read to find free slots, i.e. one per level
+	                                    of the bitmap for each word of slots searched */
+};
+
+template <typename=void>
+struct StatsCounters {
+	static Stats current;
+};
+template <typename T>
+Stats StatsCounters<T>::current {};
+
+/**< The counters accumulated since the start of the program or the last resetStats(). */
+inline Stats const& stats() {return StatsCounters<>::current;}
+inline void resetStats() {StatsCounters<>::current = {};}
+
+namespace detail {
+#ifdef CONSTAINER_STATS
+	constexpr void countStat(STD::uint64_t Stats::* counter, STD::uint64_t n = 1) {
+		if (!isConstantEvaluated())
+			StatsCounters<>::current.*counter += n;
+	}
+#else
+	constexpr void countStat(STD::uint64_t Stats::*, STD::uint64_t = 1) {}
+#endif
+}
+
+}
@@ -0,0 +1,61 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "../Math.hxx"
+
+#include <cstring> // memchr, strlen
+
+#if defined __AVX2__
+	#include <immintrin.h>
+#elif defined __SSE2__
+	#include <emmintrin.h>
+#endif
+
+namespace Constainer { namespace detail {
+
+/**< At runtime, CharTraits operates on single-byte integral characters with the kernels below, which are vectorised
+     either by the C library (memchr, strlen) or with SSE2/AVX2 where the target supports them. The character-wise
+     loops remain as the implementation for constant expressions. */
+template <typename Char>
+constexpr bool scanBytewise() {return STD::is_integral<Char>{} && sizeof(Char) == 1 && !isConstantEvaluated();}
+
+template <typename Char>
+Char const* memFind(Char const* s, STD::size_t n, Char a) {
+	return static_cast<Char const*>(STD::memchr(s, static_cast<unsigned char>(a), n));
+}
+
+template <typename Char>
+STD::size_t strLength(Char const* s) {
+	return STD::strlen(reinterpret_cast<char const*>(s));
+}
+
+/**< The index of the first byte at which [s1, s1+n) and [s2, s2+n) differ, or n. */
+inline STD::size_t firstMismatch(void const* s1, void const* s2, STD::size_t n) {
+	auto p1 = static_cast<unsigned char const*>(s1),
+	     p2 = static_cast<unsigned char const*>(s2);
+	STD::size_t i = 0;
+#if defined __AVX2__
+	for (; i + 32 <= n; i += 32) {
+		auto equal = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p1 + i)),
+		                               _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p2 + i)));
+		if (auto mask = ~static_cast<STD::uint32_t>(_mm256_movemask_epi8(equal)))
+			return i + count_trailing(mask);
+	}
+#endif
+#if defined __SSE2__
+	for (; i + 16 <= n; i += 16) {
+		auto equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p1 + i)),
+		                            _mm_loadu_si128(reinterpret_cast<__m128i const*>(p2 + i)));
+		if (auto mask = ~static_cast<STD::uint32_t>(_mm_movemask_epi8(equal)) & 0xFFFF)
+			return i + count_trailing(mask);
+	}
+#endif
+	while (i < n && p1[i] == p2[i])
+		++i;
+	return i;
+}
+
+}}